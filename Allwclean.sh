@@ -4,6 +4,7 @@ set -x
 
 wclean MeshSmoother
 wclean
+wclean smootherBenchmark
 
 
 # ---------------------------------------------------------------- end-of-file
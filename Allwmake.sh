@@ -4,8 +4,18 @@ set -x
 
 export EXTBLOCKMESH_CODE=$PWD
 
+# -mixedPrecision: store the smoother points and qualities in float, the
+# library and the applications must be built with the same flags, run
+# Allwclean.sh when switching
+export EXTBLOCKMESH_FLAGS=
+if [ "$1" = "-mixedPrecision" ]
+then
+    export EXTBLOCKMESH_FLAGS=-DSMOOTHER_MIXED_PRECISION
+fi
+
 wmake MeshSmoother
 wmake
 wmake hexMeshSmoother
+wmake smootherBenchmark
 
 # ----------------------------------------------------------------- end	of-file
@@ -33,17 +33,75 @@ License
 #include "SmootherControl.h"
 #include "SmootherParameter.h"
 #include "SmootherBoundary.h"
+#include "SmootherMultiLevel.h"
+#include "SmootherActiveSet.h"
+#include "SmootherRenumber.h"
+#include "SmootherScheduler.h"
+#include "SmootherKernel.h"
+#include "SmootherAnderson.h"
+#include "SmootherHeap.h"
+#include "SmootherOptimiser.h"
 
 #include <algorithm>
 #include <cmath>
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+// * * * * * * * * * * * * * * * Local Functions * * * * * * * * * * * * * * //
+
+namespace Foam
+{
+    // Point updates run by the schedulers
+    struct snapOp
+    {
+        const SmootherBoundary& bnd;
+        void operator()(const label ptI) const {bnd.pt(ptI)->snap(bnd);}
+    };
+
+    struct laplaceOp
+    {
+        const SmootherBoundary& bnd;
+        void operator()(const label ptI) const
+        {
+            bnd.pt(ptI)->laplaceSmooth(bnd);
+        }
+    };
+
+    struct GETMeOp
+    {
+        const SmootherBoundary& bnd;
+        void operator()(const label ptI) const
+        {
+            bnd.pt(ptI)->GETMeSmooth(bnd);
+        }
+    };
+}
+
 // * * * * * * * * * * * * * * * Private Functions * * * * * * * * * * * * * //
 
+inline Foam::SmootherCell& Foam::MeshSmoother::cell(const label cellI)
+{
+    return _cell[_cellSlot[cellI]];
+}
+
+inline const Foam::SmootherCell& Foam::MeshSmoother::cell
+(
+    const label cellI
+) const
+{
+    return _cell[_cellSlot[cellI]];
+}
+
 void MeshSmoother::analyseMeshQuality()
 {
-    forAll(_cell, cellI)
+    const label n = _cell.size();
+
+    #pragma omp parallel for schedule(static) num_threads(_nThreads)
+    for (label slotI = 0; slotI < n; ++slotI)
     {
-        _cell[cellI]->computeQuality();
+        _cell[slotI].computeQuality(*_bnd);
     }
 }
 
@@ -51,37 +109,93 @@ void Foam::MeshSmoother::analyseMeshQuality(const labelHashSet &cell)
 {
     forAllConstIter(labelHashSet , cell, cellI)
     {
-        _cell[cellI.key()]->computeQuality();
+        cell(cellI.key()).computeQuality(*_bnd);
+    }
+
+    if (_activeIteration)
+    {
+        _active->markChanged(cell);
     }
 }
 
 void Foam::MeshSmoother::qualityStats()
 {
+    const label nCells = _cell.size();
     scalar minQuality = 1.0;
     scalar meanQuality = 0.0;
 
-    scalarList pQSum(_polyMesh->nPoints(), 0.0);
-    forAll(_polyMesh->cells(), cellI)
+    if (_ctrl->deterministic())
+    { // Fixed blocks and summation tree, the same mean on any thread count
+
+        scalarField q(nCells);
+
+        #pragma omp parallel for schedule(static) num_threads(_nThreads)
+        for (label slotI = 0; slotI < nCells; ++slotI)
+        {
+            q[slotI] = _cell[slotI].quality();
+        }
+
+        minQuality = min(minQuality, min(q));
+        meanQuality = SmootherKernel::deterministicSum
+        (
+            q.cdata(),
+            nCells,
+            _nThreads
+        );
+    }
+    else
     {
-        const scalar& cQ = _cell[cellI]->quality();
-        if (cQ < minQuality)
+        #pragma omp parallel for schedule(static) num_threads(_nThreads) \
+            reduction(+:meanQuality) reduction(min:minQuality)
+        for (label slotI = 0; slotI < nCells; ++slotI)
         {
-            minQuality = cQ;
+            const scalar cQ = _cell[slotI].quality();
+            if (cQ < minQuality)
+            {
+                minQuality = cQ;
+            }
+
+            meanQuality += cQ;
         }
+    }
+
+    if (_activeIteration)
+    { // Only the points of the changed cells have a new average quality
 
-        meanQuality += cQ;
+        labelHashSet changedPoints;
+        forAllConstIter(labelHashSet, _active->changedCells(), cellI)
+        {
+            changedPoints.insert(_polyMesh->cellPoints()[cellI.key()]);
+        }
 
-        forAll(_polyMesh->cellPoints()[cellI], pointI)
+        forAllConstIter(labelHashSet, changedPoints, ptI)
         {
-            pQSum[_polyMesh->cellPoints()[cellI][pointI]] += cQ;
+            const labelList& pC = _polyMesh->pointCells()[ptI.key()];
+            scalar pQSum = 0.0;
+            forAll(pC, cellI)
+            {
+                pQSum += cell(pC[cellI]).quality();
+            }
+            _bnd->pt(ptI.key())->setQuality(pQSum/pC.size());
         }
     }
-    forAll(_polyMesh->points(), ptI)
-    {
-        _bnd->pt(ptI)->setQuality
-        (
-            pQSum[ptI]/_polyMesh->pointCells()[ptI].size()
-        );
+    else
+    { // Gathered per point in pointCells order, independent of the threads
+
+        const labelListList& pointCells = _polyMesh->pointCells();
+        const label nPoints = pointCells.size();
+
+        #pragma omp parallel for schedule(static) num_threads(_nThreads)
+        for (label ptI = 0; ptI < nPoints; ++ptI)
+        {
+            const labelList& pC = pointCells[ptI];
+            scalar pQSum = 0.0;
+            forAll(pC, cellI)
+            {
+                pQSum += cell(pC[cellI]).quality();
+            }
+            _bnd->pt(ptI)->setQuality(pQSum/pC.size());
+        }
     }
 
     meanQuality /= _polyMesh->nCells();
@@ -90,143 +204,767 @@ void Foam::MeshSmoother::qualityStats()
     _param->setMeanQual(meanQuality);
 }
 
+void Foam::MeshSmoother::addTransformedCellWeight
+(
+    const label cellI,
+    labelHashSet& tp
+)
+{
+    const SmootherCell& c = cell(cellI);
+    if (c.quality() <= _param->transformationTreshold())
+    {
+        const FixedList<point, 8> newCellPoints = c.geometricTransform
+        (
+            *_bnd,
+            c.transformParameter()
+        );
+        const scalar cQ = c.quality();
+
+        if (cQ < VSMALL)
+        {
+            FatalErrorIn("Foam::MeshSmoother::weightingFactor()")
+                << "Quality of cell " << cellI << " is null" << nl
+                << exit(FatalError);
+        }
+
+        for (label pointI = 0; pointI < 8; ++pointI)
+        {
+            const label pointJ = c.pt(pointI);
+            SmootherPoint* pt = _bnd->pt(pointJ);
+
+            // compute the associated weight
+            const label nNei = _polyMesh->pointCells(pointJ).size();
+            const scalar weight = std::sqrt(pt->avgQual()/(nNei*cQ));
+
+            // add the weight to temporary weighted sum
+            pt->addWeight(weight, newCellPoints[pointI]);
+
+            // add point to set of tranformed points
+            tp.insert(pointJ);
+        }
+    }
+}
+
 Foam::labelHashSet Foam::MeshSmoother::addTransformedElementNodeWeight()
 {
     labelHashSet transformedPoints;
-    forAll(_polyMesh->cells(), cellI)
+    if (_activeIteration)
+    {
+        const labelList activeCells = _active->cells();
+        forAll(activeCells, cellI)
+        {
+            addTransformedCellWeight(activeCells[cellI], transformedPoints);
+        }
+    }
+    else
     {
-        if (_cell[cellI]->quality() <= _param->transformationTreshold())
+        forAll(_cellOrder, i)
         {
-            const pointField newCellPoints = _cell[cellI]->geometricTransform();
-            const cellShape& cS = _polyMesh->cellShapes()[cellI];
-            const scalar& cQ = _cell[cellI]->quality();
+            addTransformedCellWeight(_cellOrder[i], transformedPoints);
+        }
+    }
+    return transformedPoints;
+}
+
+void Foam::MeshSmoother::addUnTransformedCellWeight(const label cellI)
+{
+    const SmootherCell& c = cell(cellI);
+    const scalar cQ = c.quality();
+
+    if (cQ < VSMALL)
+    {
+        FatalErrorIn("Foam::MeshSmoother::weightingFactor()")
+            << "Quality of cell " << cellI << " is null" << nl
+            << exit(FatalError);
+    }
+
+    for (label pointI = 0; pointI < 8; ++pointI)
+    {
+        const label pointJ = c.pt(pointI);
+        SmootherPoint* pt = _bnd->pt(pointJ);
+
+        // compute the associated weight
+        const label nNei = _polyMesh->pointCells(pointJ).size();
+        const scalar weight = std::sqrt(pt->avgQual()/(nNei*cQ));
+
+        // add the weight to temporary weighted sum
+        pt->addWeight(weight);
+    }
+}
+
+void Foam::MeshSmoother::addUnTransformedElementNodeWeight(labelHashSet &tp)
+{
+    // Add Untransformed Element Nodes And Weights
+    if (_activeIteration)
+    { // Only the cells around the transformed points can qualify
+
+        labelHashSet candidates;
+        forAllConstIter(labelHashSet, tp, ptI)
+        {
+            candidates.insert(_polyMesh->pointCells()[ptI.key()]);
+        }
 
-            if (cQ < VSMALL)
+        const labelList cells = _active->sweepOrder(candidates);
+        forAll(cells, cellI)
+        {
+            if (untransformedAndhavePointTransformed(cells[cellI], tp))
+            {
+                addUnTransformedCellWeight(cells[cellI]);
+            }
+        }
+    }
+    else
+    {
+        forAll(_cellOrder, i)
+        {
+            if (untransformedAndhavePointTransformed(_cellOrder[i], tp))
             {
-                FatalErrorIn("Foam::MeshSmoother::weightingFactor()")
-                    << "Quality of cell " << cellI << " is null" << nl
-                    << exit(FatalError);
+                addUnTransformedCellWeight(_cellOrder[i]);
             }
+        }
+    }
+}
 
-            forAll(cS, pointI)
+bool Foam::MeshSmoother::untransformedAndhavePointTransformed
+(
+    const label cellI,
+    const labelHashSet& tp
+)
+{
+    const SmootherCell& c = cell(cellI);
+    if (c.quality() > _param->transformationTreshold())
+    {
+        for (label ptI = 0; ptI < 8; ++ptI)
+        {
+            if (tp.find(c.pt(ptI)) != tp.end())
+            { // Have point transformed
+
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+void Foam::MeshSmoother::iterativeNodeRelaxation
+(
+    labelHashSet &tP,
+    const scalarList &r,
+    const relaxationKind kind,
+    labelHashSet* stuck,
+    Map<point>* previous
+)
+{
+    // The GETMe relaxations can start from the levels of the last one
+    const bool GETMe = kind == GETMeRelaxation;
+    const bool memory = GETMe && _ctrl->relaxationMemory();
+    if (memory && &r != _memoryTable)
+    {
+        const label nPoints = _polyMesh->nPoints();
+
+        #pragma omp parallel for schedule(static) num_threads(_nThreads)
+        for (label ptI = 0; ptI < nPoints; ++ptI)
+        {
+            _bnd->pt(ptI)->forgetRelaxationLevel();
+        }
+        _memoryTable = &r;
+    }
+
+    // Reset relaxation level, only read for the points to relax. The points
+    // of invalid cells joining later are reset when they join
+    labelHashSet started(tP);
+    label startLevel = 0;
+    forAllConstIter(labelHashSet, tP, ptI)
+    {
+        SmootherPoint* pt = _bnd->pt(ptI.key());
+        if (memory)
+        {
+            pt->recallRelaxationLevel(r);
+            startLevel = max(startLevel, pt->relaxLevel());
+        }
+        else
+        {
+            pt->resetRelaxationLevel();
+        }
+    }
+    const labelList relaxedPoints = memory ? tP.toc() : labelList();
+    _param->setNbMovedPoints(tP.size());
+
+    label nbRelax = 0;
+    while (!tP.empty())
+    {
+        ++nbRelax;
+        // Relax all the points marked for move
+        labelHashSet modifiedCells;
+        forAllConstIter(labelHashSet, tP, ptI)
+        {
+            SmootherPoint* pt = _bnd->pt(ptI.key());
+            if (stuck && pt->relaxLevel() == r.size() - 1)
+            {
+                stuck->insert(ptI.key());
+            }
+            if (previous && !previous->found(ptI.key()))
             {
-                SmootherPoint* pt = _bnd->pt(cS[pointI]);
+                previous->insert(ptI.key(), pt->getRelaxedPoint());
+            }
+            pt->relaxPoint(r);
 
-                // compute the associated weight
-                const label nNei = _polyMesh->pointCells(cS[pointI]).size();
-                const scalar weight = std::sqrt(pt->avgQual()/(nNei*cQ));
+            forAll(_polyMesh->pointCells()[ptI.key()], cellI)
+            {
+                modifiedCells.insert(_polyMesh->pointCells()[ptI.key()][cellI]);
+            }
+        }
 
-                // add the weight to temporary weighted sum
-                pt->addWeight(weight, newCellPoints[pointI]);
+        // compute quality with relaxed points
+        tP.clearStorage();
+        analyseMeshQuality(modifiedCells);
+        forAllConstIter(labelHashSet , modifiedCells, cellI)
+        {
+            if(cell(cellI.key()).quality() < VSMALL)
+            {
+                tP.insert(_polyMesh->cellPoints()[cellI.key()]);
+            }
+        }
 
-                // add point to set of tranformed points
-                transformedPoints.insert(cS[pointI]);
+        // Increase the relaxation level for invalid points
+        forAllIter(labelHashSet, tP, ptI)
+        {
+            SmootherPoint* pt = _bnd->pt(ptI.key());
+            if (started.insert(ptI.key()))
+            {
+                pt->resetRelaxationLevel();
             }
+            pt->addRelaxLevel(r);
         }
     }
-    return transformedPoints;
+    _param->setNbRelaxations(nbRelax);
+
+    if (memory)
+    {
+        forAll(relaxedPoints, ptI)
+        {
+            _bnd->pt(relaxedPoints[ptI])->storeRelaxationLevel();
+        }
+    }
+    if (GETMe)
+    {
+        _param->addGETMeRelaxations(nbRelax, startLevel);
+    }
 }
 
-void Foam::MeshSmoother::addUnTransformedElementNodeWeight(labelHashSet &tp)
+void Foam::MeshSmoother::localOptimisation(const labelHashSet& pts)
 {
-    // Add Untransformed Element Nodes And Weights
-    forAll (_polyMesh->cells(), cellI)
+    const labelListList& pointCells = _polyMesh->pointCells();
+    const labelListList& pointPoints = _polyMesh->pointPoints();
+
+    labelHashSet modifiedCells;
+    label nbImproved = 0;
+    forAllConstIter(labelHashSet, pts, iter)
     {
-        if (untransformedAndhavePointTransformed(cellI, tp))
+        const label ptI = iter.key();
+        SmootherPoint* pt = _bnd->pt(ptI);
+        const labelList& pC = pointCells[ptI];
+
+        // First step a quarter of the shortest edge of the point
+        const point p0 = pt->getRelaxedPoint();
+        scalar h = GREAT;
+        forAll(pointPoints[ptI], i)
         {
-            const cellShape& cS = _polyMesh->cellShapes()[cellI];
-            const scalar& cQ = _cell[cellI]->quality();
+            const point pN = _bnd->pt(pointPoints[ptI][i])->getRelaxedPoint();
+            h = min(h, mag(pN - p0));
+        }
+        h *= 0.25;
 
-            if (cQ < VSMALL)
+        bool moved = false;
+        for (label stepI = 0; stepI < _ctrl->localOptimisationSteps(); ++stepI)
+        {
+            // Worst cell around the point and its quality gradient
+            label worst = -1;
+            scalar minQ = GREAT;
+            forAll(pC, cellI)
+            {
+                if (cell(pC[cellI]).quality() < minQ)
+                {
+                    minQ = cell(pC[cellI]).quality();
+                    worst = pC[cellI];
+                }
+            }
+            if (minQ < VSMALL)
             {
-                FatalErrorIn("Foam::MeshSmoother::weightingFactor()")
-                    << "Quality of cell " << cellI << " is null" << nl
-                    << exit(FatalError);
+                break;
             }
 
-            forAll (cS, pointI)
+            const SmootherCell& c = cell(worst);
+            const FixedList<vector, 8> grad = c.qualityGradient(*_bnd);
+            vector d = vector::zero;
+            for (label pointI = 0; pointI < 8; ++pointI)
+            {
+                if (c.pt(pointI) == ptI)
+                {
+                    d = grad[pointI];
+                }
+            }
+            if (mag(d) < VSMALL)
             {
-                SmootherPoint* pt = _bnd->pt(cS[pointI]);
+                break;
+            }
+            d /= mag(d);
 
-                // compute the associated weight
-                const label nNei = _polyMesh->pointCells(cS[pointI]).size();
-                const scalar weight = std::sqrt(pt->avgQual()/(nNei*cQ));
+            // Backtracking, the moved point is projected like a GETMe point
+            const point p = pt->getRelaxedPoint();
+            bool improved = false;
+            for (scalar alpha = h; alpha > 1e-3*h && !improved; alpha *= 0.5)
+            {
+                pt->GETMeReset();
+                pt->addWeight(1.0, p + alpha*d);
+                pt->GETMeSmooth(*_bnd);
+                pt->resetPoint(pt->getMovedPoint());
+
+                scalar newMinQ = GREAT;
+                forAll(pC, cellI)
+                {
+                    SmootherCell& cellJ = cell(pC[cellI]);
+                    cellJ.computeQuality(*_bnd);
+                    newMinQ = min(newMinQ, cellJ.quality());
+                }
+                improved = newMinQ > minQ;
+            }
 
-                // add the weight to temporary weighted sum
-                pt->addWeight(weight);
+            if (!improved)
+            {
+                pt->resetPoint(p);
+                forAll(pC, cellI)
+                {
+                    cell(pC[cellI]).computeQuality(*_bnd);
+                }
+                break;
             }
+            moved = true;
+        }
+
+        if (moved)
+        {
+            ++nbImproved;
+            modifiedCells.insert(pC);
         }
     }
+
+    analyseMeshQuality(modifiedCells);
+    _param->addOptimisedPoints(nbImproved);
+}
+
+void Foam::MeshSmoother::laplaceReset(const labelList& pts)
+{
+    const label n = pts.size();
+
+    #pragma omp parallel for schedule(static) num_threads(_nThreads)
+    for (label i = 0; i < n; ++i)
+    {
+        _bnd->pt(pts[i])->laplaceReset();
+    }
+}
+
+void Foam::MeshSmoother::laplaceSmooth(const labelList& pts)
+{
+    const label n = pts.size();
+
+    #pragma omp parallel for schedule(static) num_threads(_nThreads)
+    for (label i = 0; i < n; ++i)
+    {
+        _bnd->pt(pts[i])->laplaceSmooth(*_bnd);
+    }
+}
+
+void Foam::MeshSmoother::featLaplaceSmooth(const labelList& pts)
+{
+    const label n = pts.size();
+
+    #pragma omp parallel for schedule(static) num_threads(_nThreads)
+    for (label i = 0; i < n; ++i)
+    {
+        _bnd->pt(pts[i])->featLaplaceSmooth(*_bnd);
+    }
+}
+
+void Foam::MeshSmoother::storeQuality()
+{
+    const label n = _cell.size();
+    _prevQuality.setSize(n);
+
+    #pragma omp parallel for schedule(static) num_threads(_nThreads)
+    for (label slotI = 0; slotI < n; ++slotI)
+    {
+        _prevQuality[slotI] = _cell[slotI].quality();
+    }
 }
 
-bool Foam::MeshSmoother::untransformedAndhavePointTransformed
-(
-    const label cellI,
-    const labelHashSet& tp
-)
-{
-    if (_cell[cellI]->quality() > _param->transformationTreshold())
-    {
-        const cellShape& cS = _polyMesh->cellShapes()[cellI];
-        forAll(cS, ptI)
-        {
-            if (tp.find(cS[ptI]) != tp.end())
-            { // Have point transformed
+void Foam::MeshSmoother::adaptTransformParameter(const labelList& cells)
+{
+    const scalar treshold = _param->transformationTreshold();
+    const scalar tMin = _ctrl->transformParameterMin();
+    const scalar tMax = _ctrl->transformParameterMax();
+    const label n = cells.size();
+
+    #pragma omp parallel for schedule(static) num_threads(_nThreads)
+    for (label i = 0; i < n; ++i)
+    {
+        const label slotI = _cellSlot[cells[i]];
+        SmootherCell& c = _cell[slotI];
+        if (_prevQuality[slotI] > treshold)
+        { // Not transformed
+
+            continue;
+        }
+
+        bool failed = c.quality() < _prevQuality[slotI];
+        for (label pointI = 0; pointI < 8 && !failed; ++pointI)
+        {
+            failed = _bnd->pt(c.pt(pointI))->relaxedPastStart();
+        }
+
+        const scalar t = c.transformParameter();
+        c.setTransformParameter
+        (
+            failed ? max(tMin, 0.5*t) : min(tMax, 1.2*t)
+        );
+    }
+}
+
+void Foam::MeshSmoother::colourCells()
+{
+    const labelListList& pointCells = _polyMesh->pointCells();
+
+    // Greedy colouring in sweep order, usedBy[c] is the last cell having a
+    // neighbour of colour c
+    labelList colour(_polyMesh->nCells(), -1);
+    DynamicList<label> usedBy;
+    forAll(_cellOrder, i)
+    {
+        const label cellI = _cellOrder[i];
+        const SmootherCell& c = cell(cellI);
+        for (label pointI = 0; pointI < 8; ++pointI)
+        {
+            const labelList& pC = pointCells[c.pt(pointI)];
+            forAll(pC, cellJ)
+            {
+                if (colour[pC[cellJ]] >= 0)
+                {
+                    usedBy[colour[pC[cellJ]]] = cellI;
+                }
+            }
+        }
+
+        label k = 0;
+        while (k < usedBy.size() && usedBy[k] == cellI)
+        {
+            ++k;
+        }
+        if (k == usedBy.size())
+        {
+            usedBy.append(-1);
+        }
+        colour[cellI] = k;
+    }
+
+    labelList nCells(usedBy.size(), 0);
+    forAll(colour, cellI)
+    {
+        ++nCells[colour[cellI]];
+    }
+
+    _colourCells.setSize(usedBy.size());
+    forAll(_colourCells, colourI)
+    {
+        _colourCells[colourI].setSize(nCells[colourI]);
+        nCells[colourI] = 0;
+    }
+    forAll(_cellOrder, i)
+    {
+        const label cellI = _cellOrder[i];
+        _colourCells[colour[cellI]][nCells[colour[cellI]]++] = cellI;
+    }
+
+    Info<< "  Multicolour schedule of " << _colourCells.size()
+        << " colours" << nl << nl;
+}
+
+Foam::labelHashSet Foam::MeshSmoother::transformColour
+(
+    const labelList& cells
+)
+{
+    const labelListList& pointCells = _polyMesh->pointCells();
+    const scalar treshold = _param->transformationTreshold();
+    const label n = cells.size();
+    boolList transformed(n, false);
+
+    // The cells of the colour share no point, each one moves its own points
+    // to the weighted mean of its transformation and of the other cells
+    #pragma omp parallel for schedule(dynamic, 64) num_threads(_nThreads)
+    for (label i = 0; i < n; ++i)
+    {
+        const SmootherCell& c = cell(cells[i]);
+        if (c.quality() > treshold)
+        {
+            continue;
+        }
+
+        const FixedList<point, 8> newCellPoints =
+            c.geometricTransform(*_bnd, c.transformParameter());
+        for (label pointI = 0; pointI < 8; ++pointI)
+        {
+            const label pointJ = c.pt(pointI);
+            SmootherPoint* pt = _bnd->pt(pointJ);
+            pt->GETMeReset();
+
+            const labelList& pC = pointCells[pointJ];
+            forAll(pC, cellJ)
+            {
+                const scalar cQ = cell(pC[cellJ]).quality();
+                if (cQ < VSMALL)
+                {
+                    continue;
+                }
+
+                const scalar weight = std::sqrt(pt->avgQual()/(pC.size()*cQ));
+                if (pC[cellJ] == cells[i])
+                {
+                    pt->addWeight(weight, newCellPoints[pointI]);
+                }
+                else
+                {
+                    pt->addWeight(weight);
+                }
+            }
+            pt->GETMeSmooth(*_bnd);
+        }
+        transformed[i] = true;
+    }
+
+    labelHashSet movedPoints;
+    forAll(cells, i)
+    {
+        if (transformed[i])
+        {
+            movedPoints.insert(_polyMesh->cellPoints()[cells[i]]);
+        }
+    }
+    return movedPoints;
+}
+
+void Foam::MeshSmoother::GETMeMulticolour()
+{
+    // Points reached by a relaxation without being moved keep their place
+    const label nPoints = _polyMesh->nPoints();
+
+    #pragma omp parallel for schedule(static) num_threads(_nThreads)
+    for (label ptI = 0; ptI < nPoints; ++ptI)
+    {
+        SmootherPoint* pt = _bnd->pt(ptI);
+        pt->GETMeReset();
+        pt->addWeight(1.0);
+    }
+
+    if (_ctrl->adaptiveTransform())
+    {
+        storeQuality();
+    }
+
+    // Each colour is relaxed and validated before the next one
+    label nbMoved = 0;
+    labelHashSet stuckPoints;
+    forAll(_colourCells, colourI)
+    {
+        labelHashSet movedPoints = transformColour(_colourCells[colourI]);
+        nbMoved += movedPoints.size();
+        iterativeNodeRelaxation
+        (
+            movedPoints,
+            _param->relaxationTable(),
+            GETMeRelaxation,
+            &stuckPoints
+        );
+
+        if (_ctrl->adaptiveTransform())
+        {
+            adaptTransformParameter(_colourCells[colourI]);
+        }
+    }
+    _param->setNbMovedPoints(nbMoved);
+
+    if (_ctrl->localOptimisation() && _param->minCycle())
+    {
+        localOptimisation(stuckPoints);
+    }
+}
+
+void Foam::MeshSmoother::andersonStep()
+{
+    if (!_anderson->extrapolate(*_bnd))
+    {
+        return;
+    }
+
+    // The status reports the GETMe step
+    const label nbMoved = _param->nbMovedPoints();
+    const label nbRelax = _param->nbRelaxations();
+    const scalar minQ = _param->minQual();
+    const scalar meanQ = _param->meanQual();
+
+    // The relaxation can also move the feature points of invalid cells
+    Map<point> previous;
+    labelHashSet interiorPoints(_bnd->interiorPointList());
+    iterativeNodeRelaxation
+    (
+        interiorPoints,
+        _param->relaxationTable(),
+        trialRelaxation,
+        NULL,
+        &previous
+    );
+    qualityStats();
+
+    const bool accepted =
+        _param->meanQual() >= meanQ && _param->minQual() >= minQ;
+    if (!accepted)
+    { // Back to the GETMe iterate, the history restarts from it
 
-                return true;
-            }
+        forAllConstIter(Map<point>, previous, iter)
+        {
+            _bnd->pt(iter.key())->resetPoint(iter());
         }
+        analyseMeshQuality();
+        qualityStats();
+        _anderson->clear();
     }
 
-    return false;
+    _param->addAcceleration(accepted);
+    _param->setNbMovedPoints(nbMoved);
+    _param->setNbRelaxations(nbRelax);
 }
 
-void Foam::MeshSmoother::iterativeNodeRelaxation
-(
-    labelHashSet &tP,
-    const scalarList &r
-)
+void Foam::MeshSmoother::GETMeSequential()
 {
-    // Reset relaxation level
-    forAll(_polyMesh->points(), ptI)
+    const labelListList& pointCells = _polyMesh->pointCells();
+    const scalar treshold = _param->transformationTreshold();
+    const scalarList& r = _param->relaxationTable();
+
+    _worst->clear();
+    forAll(_cellOrder, i)
     {
-        _bnd->pt(ptI)->resetRelaxationLevel();
+        const label cellI = _cellOrder[i];
+        const scalar cQ = cell(cellI).quality();
+        if (cQ <= treshold)
+        {
+            _worst->set(cellI, cQ);
+        }
     }
-    _param->setNbMovedPoints(tP.size());
 
+    labelHashSet movedPoints;
     label nbRelax = 0;
-    while (!tP.empty())
+    const label nSteps = _worst->size();
+    for (label step = 0; step < nSteps && !_worst->empty(); ++step)
     {
-        ++nbRelax;
-        // Relax all the points marked for move
-        labelHashSet modifiedCells;
-        forAllConstIter(labelHashSet, tP, ptI)
+        const label cellI = _worst->pop();
+        const SmootherCell& c = cell(cellI);
+
+        // Cells around the points of the cell and their worst quality
+        labelHashSet patch;
+        for (label pointI = 0; pointI < 8; ++pointI)
+        {
+            patch.insert(pointCells[c.pt(pointI)]);
+        }
+        scalar minQ = GREAT;
+        forAllConstIter(labelHashSet, patch, iter)
+        {
+            minQ = min(minQ, cell(iter.key()).quality());
+        }
+
+        // Transformation of the current points of the cell
+        for (label pointI = 0; pointI < 8; ++pointI)
+        {
+            _bnd->pt(c.pt(pointI))->GETMeReset();
+        }
+        const FixedList<point, 8> H =
+            c.geometricTransform(*_bnd, c.transformParameter());
+        for (label pointI = 0; pointI < 8; ++pointI)
         {
-            _bnd->pt(ptI.key())->relaxPoint(r);
+            SmootherPoint* pt = _bnd->pt(c.pt(pointI));
+            pt->addWeight(1.0, H[pointI]);
+            pt->GETMeSmooth(*_bnd);
+            pt->resetRelaxationLevel();
+        }
 
-            forAll(_polyMesh->pointCells()[ptI.key()], cellI)
+        // Relax until the worst cell of the patch improves, the last level
+        // of the table puts the points back
+        bool improved = false;
+        label level = 0;
+        for (; level < r.size() && !improved; ++level)
+        {
+            ++nbRelax;
+            for (label pointI = 0; pointI < 8; ++pointI)
             {
-                modifiedCells.insert(_polyMesh->pointCells()[ptI.key()][cellI]);
+                _bnd->pt(c.pt(pointI))->relaxPoint(r);
+            }
+
+            scalar newMinQ = GREAT;
+            forAllConstIter(labelHashSet, patch, iter)
+            {
+                SmootherCell& cellJ = cell(iter.key());
+                cellJ.computeQuality(*_bnd);
+                newMinQ = min(newMinQ, cellJ.quality());
+            }
+            improved = newMinQ > minQ;
+
+            for (label pointI = 0; pointI < 8; ++pointI)
+            {
+                _bnd->pt(c.pt(pointI))->addRelaxLevel(r);
             }
         }
 
-        // compute quality with relaxed points
-        tP.clearStorage();
-        analyseMeshQuality(modifiedCells);
-        forAllConstIter(labelHashSet , modifiedCells, cellI)
+        if (improved)
         {
-            if(_cell[cellI.key()]->quality() < VSMALL)
+            for (label pointI = 0; pointI < 8; ++pointI)
             {
-                tP.insert(_polyMesh->cellPoints()[cellI.key()]);
+                movedPoints.insert(c.pt(pointI));
             }
         }
 
-        // Increase the relaxation level for invalid points
-        forAllIter(labelHashSet, tP, ptI)
+        if (_ctrl->adaptiveTransform())
+        { // Full step improving the cell or not
+
+            const scalar tC = c.transformParameter();
+            cell(cellI).setTransformParameter
+            (
+                (improved && level == 1)
+              ? min(_ctrl->transformParameterMax(), 1.2*tC)
+              : max(_ctrl->transformParameterMin(), 0.5*tC)
+            );
+        }
+
+        // A cell which could not be improved waits for a neighbour to move
+        forAllConstIter(labelHashSet, patch, iter)
         {
-            _bnd->pt(ptI.key())->addRelaxLevel(r);
+            const label cellJ = iter.key();
+            const scalar cQ = cell(cellJ).quality();
+            if (cellJ == cellI && !improved)
+            {
+                continue;
+            }
+
+            if (cQ <= treshold)
+            {
+                _worst->set(cellJ, cQ);
+            }
+            else
+            {
+                _worst->erase(cellJ);
+            }
         }
     }
+
+    _param->setNbMovedPoints(movedPoints.size());
     _param->setNbRelaxations(nbRelax);
 }
 
@@ -238,10 +976,33 @@ bool Foam::MeshSmoother::runIteration()
     const scalar minQ = _param->minQual();
     const scalar meanQ = _param->meanQual();
 
+    // Only the GETMe steps of the mean cycle are extrapolated
+    const bool accelerate =
+        _anderson && _param->meanCycle() && _bnd->unSnapedPoints().empty();
+    if (accelerate)
+    {
+        _anderson->begin(*_bnd);
+    }
+    else if (_anderson)
+    {
+        _anderson->clear();
+    }
+
+    const bool optimise =
+        _optimiser && _param->minCycle() && _bnd->unSnapedPoints().empty();
+    if (!optimise && _optimiser)
+    {
+        _optimiser->clear();
+    }
+
     if (!_bnd->unSnapedPoints().empty())
     {
         snapSmoothing();
     }
+    else if (optimise)
+    {
+        optimisationSmoothing();
+    }
     else
     {
         GETMeSmoothing();
@@ -249,6 +1010,11 @@ bool Foam::MeshSmoother::runIteration()
 
     // Compute new min and avg quality
     qualityStats();
+
+    if (accelerate)
+    {
+        andersonStep();
+    }
     _param->printStatus(_bnd->unSnapedPoints().size());
 
     const bool asUnSnaped = _bnd->unSnapedPoints().empty();
@@ -263,6 +1029,19 @@ pointField MeshSmoother::getMovedPoints() const
     {
         pt[ptI] = _bnd->pt(ptI)->getRelaxedPoint();
     }
+
+#ifdef SMOOTHER_MIXED_PRECISION
+    // Points which did not move keep their double precision position
+    const pointField& meshPts = _polyMesh->points();
+    forAll(pt, ptI)
+    {
+        if (storePoint(meshPts[ptI]) == storePoint(pt[ptI]))
+        {
+            pt[ptI] = meshPts[ptI];
+        }
+    }
+#endif
+
     return pt;
 }
 
@@ -274,7 +1053,7 @@ void Foam::MeshSmoother::writeMesh
 {
     forAll(meshQuality, cellI)
     {
-        meshQuality[cellI] = _cell[cellI]->quality();
+        meshQuality[cellI] = cell(cellI).quality();
     }
 
     if (!meshFv.write())
@@ -284,7 +1063,7 @@ void Foam::MeshSmoother::writeMesh
             << exit(FatalError);
     }
 
-    if (!_polyMesh->write())
+    if (&meshFv != _polyMesh && !_polyMesh->write())
     {
         FatalErrorIn("Foam::MeshSmoother::writeMesh()")
             << "Failed writing polyMesh."
@@ -294,35 +1073,83 @@ void Foam::MeshSmoother::writeMesh
 
 void MeshSmoother::GETMeSmoothing()
 {
-    //-------------------------------------------------------------------------
-
-    // Reset all points
-    forAll(_polyMesh->points(), ptI)
+    // Restrict the min cycle to the cells below the treshold
+    const bool multicolour = !_colourCells.empty();
+    const bool sequential = _worst && _param->minCycle();
+    _activeIteration =
+        _active->enabled() && _param->minCycle()
+     && !multicolour && !sequential;
+    if (_activeIteration)
     {
-        _bnd->pt(ptI)->laplaceReset();
+        _active->update
+        (
+            _cell,
+            _param->transformationTreshold(),
+            _param->minCycleNb()
+        );
     }
 
+    //-------------------------------------------------------------------------
+
+    // Reset all points, the interior points of invalid cells can join the
+    // feature relaxation
+    laplaceReset(_bnd->interiorPointList());
+    laplaceReset(_bnd->featuresPointList());
+
     // LaplaceSmooth boundary points
+    featLaplaceSmooth(_bnd->featuresPointList());
     labelHashSet snapPoints = _bnd->featuresPoints();
-    forAllConstIter(labelHashSet, snapPoints, ptI)
-    {
-        _bnd->pt(ptI.key())->featLaplaceSmooth();
-    }
-    iterativeNodeRelaxation(snapPoints, _ctrl->snapRelaxTable());
+    iterativeNodeRelaxation
+    (
+        snapPoints,
+        _ctrl->snapRelaxTable(),
+        snapRelaxation
+    );
 
     // Snap boundary points
+    const snapOp snapPts = {*_bnd};
+    _featureLoop->run(snapPts);
     snapPoints = _bnd->featuresPoints();
-    forAllConstIter(labelHashSet, snapPoints, ptI)
+    iterativeNodeRelaxation
+    (
+        snapPoints,
+        _ctrl->snapRelaxTable(),
+        snapRelaxation
+    );
+
+    //-------------------------------------------------------------------------
+
+    if (sequential)
     {
-        _bnd->pt(ptI.key())->snap();
+        GETMeSequential();
+        return;
     }
-    iterativeNodeRelaxation(snapPoints, _ctrl->snapRelaxTable());
 
-    //-------------------------------------------------------------------------
+    if (multicolour)
+    {
+        GETMeMulticolour();
+        return;
+    }
 
-    forAll(_polyMesh->points(), ptI)
+    if (_activeIteration)
+    {
+        const labelList haloPoints = _active->haloPoints();
+        forAll(haloPoints, ptI)
+        {
+            _bnd->pt(haloPoints[ptI])->GETMeReset();
+        }
+    }
+    else
+    {
+        forAll(_polyMesh->points(), ptI)
+        {
+            _bnd->pt(ptI)->GETMeReset();
+        }
+    }
+
+    if (_ctrl->adaptiveTransform())
     {
-        _bnd->pt(ptI)->GETMeReset();
+        storeQuality();
     }
 
     labelHashSet transformedPoints = addTransformedElementNodeWeight();
@@ -333,53 +1160,102 @@ void MeshSmoother::GETMeSmoothing()
     }
 
     // Compute new point
-    forAllConstIter(labelHashSet, transformedPoints, ptI)
+    const GETMeOp GETMePts = {*_bnd};
+    SmootherScheduler(*_bnd, transformedPoints.toc(), _nThreads).run(GETMePts);
+
+    labelHashSet stuckPoints;
+    iterativeNodeRelaxation
+    (
+        transformedPoints,
+        _param->relaxationTable(),
+        GETMeRelaxation,
+        &stuckPoints
+    );
+
+    if (_ctrl->adaptiveTransform())
     {
-        _bnd->pt(ptI.key())->GETMeSmooth();
+        adaptTransformParameter
+        (
+            _activeIteration ? _active->cells() : _cellOrder
+        );
     }
 
-    iterativeNodeRelaxation(transformedPoints, _param->relaxationTable());
+    if (_ctrl->localOptimisation() && _param->minCycle())
+    {
+        localOptimisation(stuckPoints);
+    }
 
 //    _bnd->writeAllSurfaces(_param->getIterNb());
 }
 
+void MeshSmoother::optimisationSmoothing()
+{
+    _activeIteration = false;
+
+    bool moved = false;
+    const label nbTrials = _optimiser->step(moved);
+
+    _param->setNbMovedPoints(moved ? _optimiser->size() : 0);
+    _param->setNbRelaxations(nbTrials);
+}
+
 void MeshSmoother::snapSmoothing()
 {
+    _activeIteration = false;
+
     // Reset all points
-    forAll(_polyMesh->points(), ptI)
+    laplaceReset(_bnd->interiorPointList());
+    laplaceReset(_bnd->featuresPointList());
+
+    // Snap boundary points and LaplaceSmooth interior points together, both
+    // only read the initial points and write their own moved point. The
+    // tasks of both loops share the threads, the relaxations below check
+    // the cells touching both sets
+    const snapOp snapPts = {*_bnd};
+    const laplaceOp laplacePts = {*_bnd};
+
+    #pragma omp parallel num_threads(_nThreads)
+    #pragma omp single
     {
-        _bnd->pt(ptI)->laplaceReset();
+        #pragma omp task
+        _featureLoop->spawn(snapPts);
+
+        _interiorLoop->spawn(laplacePts);
+
+        #pragma omp taskwait
     }
 
-    // LaplaceSmooth interior points
     labelHashSet laplacePoints = _bnd->interiorPoints();
-    forAllConstIter(labelHashSet, laplacePoints, ptI)
-    {
-        _bnd->pt(ptI.key())->laplaceSmooth();
-    }
-    iterativeNodeRelaxation(laplacePoints, _ctrl->snapRelaxTable());
+    iterativeNodeRelaxation
+    (
+        laplacePoints,
+        _ctrl->snapRelaxTable(),
+        snapRelaxation
+    );
 
-    // Snap boundary points
     labelHashSet snapPoints = _bnd->featuresPoints();
-    forAllConstIter(labelHashSet, snapPoints, ptI)
-    {
-        _bnd->pt(ptI.key())->snap();
-    }
-    iterativeNodeRelaxation(snapPoints, _ctrl->snapRelaxTable());
+    iterativeNodeRelaxation
+    (
+        snapPoints,
+        _ctrl->snapRelaxTable(),
+        snapRelaxation
+    );
 
     // Remove points from unsnaped point list if snaped
     forAll(_polyMesh->points(), ptI)
     {
-        _bnd->pt(ptI)->needSnap();
+        _bnd->pt(ptI)->needSnap(*_bnd);
     }
 
     // LaplaceSmooth boundary points
+    featLaplaceSmooth(_bnd->featuresPointList());
     snapPoints = _bnd->featuresPoints();
-    forAllConstIter(labelHashSet, snapPoints, ptI)
-    {
-        _bnd->pt(ptI.key())->featLaplaceSmooth();
-    }
-    iterativeNodeRelaxation(snapPoints, _ctrl->snapRelaxTable());
+    iterativeNodeRelaxation
+    (
+        snapPoints,
+        _ctrl->snapRelaxTable(),
+        snapRelaxation
+    );
 }
 
 // * * * * * * * * * * * * * * * * Constructors  * * * * * * * * * * * * * * //
@@ -388,28 +1264,172 @@ Foam::MeshSmoother::MeshSmoother
 (
     polyMesh *mesh,
     dictionary *smootherDict,
-    blockMesh *blocks
+    blockMesh *blocks,
+    SmootherSurfaceCache* surfCache,
+    const label maxThreads
 )
 :
     _polyMesh(mesh),
-    _blocks(blocks)
+    _blocks(blocks),
+    _anderson(NULL),
+    _worst(NULL),
+    _optimiser(NULL),
+    _activeIteration(false),
+    _nThreads(1),
+    _memoryTable(NULL)
 {
     scalar time = _polyMesh->time().elapsedCpuTime();
 
     _ctrl = new SmootherControl(smootherDict);
     _param = new SmootherParameter(_ctrl, _polyMesh);
+#ifdef _OPENMP
+    _nThreads =
+        _ctrl->nThreads() > 0 ? _ctrl->nThreads() : omp_get_max_threads();
+    if (maxThreads > 0)
+    {
+        _nThreads = min(_nThreads, maxThreads);
+    }
+#endif
+
+    // Pin the threads before they first touch the tables
+    SmootherStorage::pinThreads(_ctrl->pinThreads(), _nThreads);
+    _memory = SmootherStorage(*_ctrl, _nThreads);
+    if (_memory.outOfCore())
+    {
+        Info<< "    Out-of-core: the point and cell tables are mapped, the "
+            << "mesh addressing stays in memory" << nl;
+    }
+
+    // Place the cells and points so that neighbours are close in memory
+    const SmootherRenumber::method renumbering =
+        SmootherRenumber::methodFromName(_ctrl->renumbering());
+    _cellOrder = SmootherRenumber::cellOrder(*_polyMesh, renumbering);
+    _cellSlot = invert(_polyMesh->nCells(), _cellOrder);
+
     dictionary& snapDict = smootherDict->subDict("snapControls");
-    _bnd = new SmootherBoundary(snapDict, _polyMesh);
-    _cell = List<SmootherCell*>(_polyMesh->nCells());
+    if (renumbering == SmootherRenumber::NONE)
+    {
+        _bnd = new SmootherBoundary(snapDict, _polyMesh, surfCache, &_memory);
+    }
+    else
+    {
+        const labelList pointOrder =
+            SmootherRenumber::pointOrder(*_polyMesh, _cellOrder);
+        _bnd = new SmootherBoundary
+        (
+            snapDict,
+            _polyMesh,
+            surfCache,
+            &_memory,
+            &pointOrder
+        );
+    }
 
-    SmootherPoint dummyPoint;
-    dummyPoint.setStaticItems(_bnd, _param, _polyMesh);
+    _featureLoop = new SmootherScheduler
+    (
+        *_bnd,
+        _bnd->featuresPointList(),
+        _nThreads
+    );
+    _interiorLoop = new SmootherScheduler
+    (
+        *_bnd,
+        _bnd->interiorPointList(),
+        _nThreads
+    );
+
+    if (_ctrl->anderson())
+    {
+        _anderson = new SmootherAnderson
+        (
+            _bnd->interiorPointList(),
+            _ctrl->andersonDepth(),
+            _nThreads,
+            _ctrl->deterministic()
+        );
+    }
+
+    if (_polyMesh->nPoints() > SmootherCell::maxPoints())
+    {
+        FatalErrorIn("Foam::MeshSmoother::MeshSmoother()")
+            << "Mesh has " << _polyMesh->nPoints() << " points, the smoother "
+            << "cells address at most " << SmootherCell::maxPoints()
+            << " points" << exit(FatalError);
+    }
+
+    _cell.reserve(_polyMesh->nCells(), &_memory);
+    _active = new SmootherActiveSet
+    (
+        _polyMesh,
+        _cellSlot,
+        _ctrl->activeSet(),
+        _ctrl->activeSetHalo(),
+        _ctrl->activeSetMaxNoImprove()
+    );
+
+    const cellShapeList& shapes = _polyMesh->cellShapes();
+    forAll(_cellOrder, i)
+    {
+        new (_cell.allocate()) SmootherCell
+        (
+            shapes[_cellOrder[i]],
+            _ctrl->transformationParameter()
+        );
+    }
+
+    // Build the demand-driven addressing once, the smoother then only reads
+    // its own mesh and can run beside other smoothers of the process
+    _polyMesh->pointPoints();
+    _polyMesh->pointCells();
+    _polyMesh->cellPoints();
+
+    if (_ctrl->schedule() == "multicolour")
+    {
+        colourCells();
+    }
+    else if (_ctrl->schedule() != "jacobi")
+    {
+        FatalErrorIn("Foam::MeshSmoother::MeshSmoother()")
+            << "Unknown schedule " << _ctrl->schedule() << ", valid "
+            << "schedules are jacobi and multicolour" << exit(FatalError);
+    }
+
+    if (_ctrl->minCycleEngine() == "sequential")
+    {
+        _worst = new SmootherHeap(_polyMesh->nCells());
+    }
+    else if (_ctrl->minCycleEngine() == "optimisation")
+    {
+        _optimiser = new SmootherOptimiser
+        (
+            *_bnd,
+            _cell,
+            _cellSlot,
+            *_ctrl,
+            _nThreads
+        );
+    }
+    else if (_ctrl->minCycleEngine() != "simultaneous")
+    {
+        FatalErrorIn("Foam::MeshSmoother::MeshSmoother()")
+            << "Unknown min cycle engine " << _ctrl->minCycleEngine()
+            << ", valid engines are simultaneous, sequential and "
+            << "optimisation" << exit(FatalError);
+    }
 
-    forAll(_cell, cellI)
+    // Smooth the subsampled block lattices first
+    if (_blocks && _ctrl->multiLevels() > 0)
     {
-        _cell[cellI] = new SmootherCell(_polyMesh->cellShapes()[cellI]);
+        SmootherMultiLevel multiLevel
+        (
+            _blocks,
+            _bnd,
+            _ctrl,
+            _polyMesh->nPoints(),
+            _nThreads
+        );
+        multiLevel.smooth();
     }
-    _cell[0]->setStaticItems(_bnd,_ctrl->transformationParameter());
 
     // Analyse initial quality
     analyseMeshQuality();
@@ -417,6 +1437,11 @@ Foam::MeshSmoother::MeshSmoother
 
     //snapFeatures();
 
+    if (_ctrl->placementReport())
+    {
+        _memory.placementReport();
+    }
+
     Info<< "Smoother initialized in "
         << _polyMesh->time().elapsedCpuTime() - time << " s" << nl << nl
         << "Smooth the mesh" << nl << nl;
@@ -432,11 +1457,12 @@ Foam::MeshSmoother::MeshSmoother
 
 Foam::MeshSmoother::~MeshSmoother()
 {
-    forAll(_cell, cellI)
-    {
-        delete _cell[cellI];
-    }
-
+    delete _active;
+    delete _anderson;
+    delete _worst;
+    delete _optimiser;
+    delete _interiorLoop;
+    delete _featureLoop;
     delete _param;
     delete _bnd;
     delete _ctrl;
@@ -448,8 +1474,9 @@ void Foam::MeshSmoother::update()
 {
     while(runIteration()){}
 
-    // Update the mesh with new points
+    // Update the mesh with new points, the old points are not kept
     _polyMesh->movePoints(getMovedPoints());
+    _polyMesh->resetMotion();
 
     _param->printStats();
 }
@@ -462,17 +1489,29 @@ void Foam::MeshSmoother::updateAndWrite
     Time& runTime
 )
 {
-    fvMesh meshFv
-    (
-        IOobject(regionName, runTime.constant(), runTime),
-        xferCopy(_polyMesh->points()),
-        _blocks->cells(),
-        _blocks->patches(),
-        _blocks->patchNames(),
-        _blocks->patchDicts(),
-        defaultFacesName,
-        defaultFacesType
-    );
+    // Write through the smoothed mesh itself when it is an fvMesh, a copy
+    // is only built for a polyMesh
+    fvMesh* meshFvPtr = dynamic_cast<fvMesh*>(_polyMesh);
+    autoPtr<fvMesh> meshCopy;
+    if (!meshFvPtr)
+    {
+        meshCopy.reset
+        (
+            new fvMesh
+            (
+                IOobject(regionName, runTime.constant(), runTime),
+                xferCopy(_polyMesh->points()),
+                _blocks->cells(),
+                _blocks->patches(),
+                _blocks->patchNames(),
+                _blocks->patchDicts(),
+                defaultFacesName,
+                defaultFacesType
+            )
+        );
+        meshFvPtr = meshCopy.operator->();
+    }
+    fvMesh& meshFv = *meshFvPtr;
 
     volScalarField meshQuality
     (
@@ -494,6 +1533,7 @@ void Foam::MeshSmoother::updateAndWrite
     {
         // Update the mesh with new points
         _polyMesh->movePoints(getMovedPoints());
+        _polyMesh->resetMotion();
 
         ++runTime;
         writeMesh(meshFv, meshQuality);
@@ -505,15 +1545,117 @@ void Foam::MeshSmoother::updateAndWrite
 Foam::scalar Foam::MeshSmoother::getTransformationTreshold() const
 {
     scalarList cqs(_polyMesh->nCells());
-    forAll(_polyMesh->cells(), cellI)
+    forAll(_cell, slotI)
     {
-        cqs[cellI] = _cell[cellI]->quality();
+        cqs[slotI] = _cell[slotI].quality();
     }
     std::sort(cqs.begin(), cqs.end());
 
     return cqs[std::floor(_polyMesh->nCells()*_ctrl->ratioForMin())];
 }
 
+Foam::scalarField Foam::MeshSmoother::cellQuality() const
+{
+    scalarField q(_cell.size());
+    forAll(q, cellI)
+    {
+        q[cellI] = cell(cellI).quality();
+    }
+    return q;
+}
+
+Foam::label Foam::MeshSmoother::nbIterations() const
+{
+    return _param->getIterNb();
+}
+
+Foam::wordList Foam::MeshSmoother::findRegions
+(
+    const Time& runTime,
+    const word& meshFile
+)
+{
+    DynamicList<word> regions;
+
+    if (isFile(runTime.constant()/polyMesh::meshSubDir/meshFile))
+    {
+        regions.append(polyMesh::defaultRegion);
+    }
+
+    const fileNameList dirs = readDir(runTime.constant(), fileName::DIRECTORY);
+    forAll(dirs, dirI)
+    {
+        if (isFile(runTime.constant()/dirs[dirI]/polyMesh::meshSubDir/meshFile))
+        {
+            regions.append(dirs[dirI]);
+        }
+    }
+
+    return regions;
+}
+
+Foam::label Foam::MeshSmoother::regionThreads
+(
+    const label nThreads,
+    const label nRegions
+)
+{
+#ifdef _OPENMP
+    const label nAvailable = nThreads > 0 ? nThreads : omp_get_max_threads();
+    return max(1, nAvailable/max(nRegions, 1));
+#else
+    return 1;
+#endif
+}
+
+void Foam::MeshSmoother::updateAll
+(
+    PtrList<MeshSmoother>& smoothers,
+    const label nThreads
+)
+{
+    const label nSmoothers = smoothers.size();
+    if (nSmoothers == 1)
+    {
+        smoothers[0].update();
+        return;
+    }
+
+#ifdef _OPENMP
+    const label nAvailable = nThreads > 0 ? nThreads : omp_get_max_threads();
+    const label nUsed = max(1, min(nAvailable, nSmoothers));
+
+    Info<< "Smoothing " << nSmoothers << " meshes, " << nUsed
+        << " at a time on " << regionThreads(nThreads, nSmoothers)
+        << " threads each" << nl << nl;
+
+    // The point loops of each smoother run in a nested team
+    const int maxLevels = omp_get_max_active_levels();
+    omp_set_max_active_levels(2);
+
+    forAll(smoothers, i)
+    {
+        smoothers[i]._param->bufferOutput();
+    }
+
+    #pragma omp parallel for schedule(dynamic, 1) num_threads(nUsed)
+    for (label i = 0; i < nSmoothers; ++i)
+    {
+        smoothers[i].update();
+
+        #pragma omp critical(smootherOutput)
+        smoothers[i]._param->flushOutput(smoothers[i]._polyMesh->name());
+    }
+
+    omp_set_max_active_levels(maxLevels);
+#else
+    for (label i = 0; i < nSmoothers; ++i)
+    {
+        smoothers[i].update();
+    }
+#endif
+}
+
 // * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * //
 
 // ************************************************************************* //
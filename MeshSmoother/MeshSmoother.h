@@ -25,6 +25,8 @@ License
 
 #include "fvCFD.H"
 
+#include "SmootherPool.h"
+
 #include <map>
 
 // * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * //
@@ -37,6 +39,12 @@ class blockMesh;
 class SmootherControl;
 class SmootherParameter;
 class SmootherBoundary;
+class SmootherActiveSet;
+class SmootherSurfaceCache;
+class SmootherScheduler;
+class SmootherAnderson;
+class SmootherHeap;
+class SmootherOptimiser;
 
 /*---------------------------------------------------------------------------*\
                       Class blockMeshSmoother Declaration
@@ -46,6 +54,14 @@ class MeshSmoother
 {
     //- Private data
 
+        // Enum relaxation type, a trial move is undone if rejected
+        enum relaxationKind
+        {
+            snapRelaxation,
+            GETMeRelaxation,
+            trialRelaxation
+        };
+
         // Pointer of parents
         polyMesh *_polyMesh;
         blockMesh *_blocks;
@@ -54,19 +70,66 @@ class MeshSmoother
         SmootherControl* _ctrl;
         SmootherParameter* _param;
         SmootherBoundary* _bnd;
+        SmootherActiveSet* _active;
+
+        // Cost balanced loops over the feature and the interior points
+        SmootherScheduler* _featureLoop;
+        SmootherScheduler* _interiorLoop;
+
+        // Anderson acceleration of the mean cycle, NULL if not used
+        SmootherAnderson* _anderson;
+
+        // Cells below the treshold worst first for the sequential min
+        // cycle, NULL if the min cycle is simultaneous
+        SmootherHeap* _worst;
+
+        // L-BFGS engine of the min cycle, NULL if not used
+        SmootherOptimiser* _optimiser;
+
+        // Is the current iteration restricted to the active set
+        bool _activeIteration;
+
+        // Number of threads of the point loops
+        label _nThreads;
 
-        // Smoother cell and points
-        List<SmootherCell*> _cell;
+        // Memory of the point and cell tables, declared first so that it
+        // outlives them
+        SmootherStorage _memory;
+
+        // Flat table of the smoother cells, placed in sweep order
+        SmootherPool<SmootherCell> _cell;
+
+        // Mesh cells in sweep order and table slot of each mesh cell
+        labelList _cellOrder;
+        labelList _cellSlot;
+
+        // Cells of each colour of the multicolour schedule, the cells of a
+        // colour share no point
+        labelListList _colourCells;
+
+        // Quality of each cell slot before the transformation, for the
+        // adaptive transformation parameter
+        scalarList _prevQuality;
+
+        // Relaxation table of the remembered point levels, the levels are
+        // forgotten when the cycle changes the table
+        const scalarList* _memoryTable;
 
     //- Private member functions
 
+        // Smoother cell of mesh cell cellI
+        inline SmootherCell& cell(const label cellI);
+        inline const SmootherCell& cell(const label cellI) const;
+
         // Quality analysis
         void analyseMeshQuality();
         void analyseMeshQuality(const labelHashSet &cell);
         void qualityStats();
 
         // GETMe smoothing
+        void addTransformedCellWeight(const label cellI, labelHashSet& tp);
         labelHashSet addTransformedElementNodeWeight();
+        void addUnTransformedCellWeight(const label cellI);
         void addUnTransformedElementNodeWeight(labelHashSet &tp);
         bool untransformedAndhavePointTransformed
         (
@@ -74,7 +137,49 @@ class MeshSmoother
             const labelHashSet& tp
         );
 
-        void iterativeNodeRelaxation(labelHashSet &tP, const scalarList &r);
+        // Relax the moved points until their cells are valid, the points
+        // put back by the last level of r are added to stuck. Only the
+        // GETMe relaxations are counted and use the relaxation memory. With
+        // previous, the points are stored there before their first
+        // relaxation, to undo a trial move
+        void iterativeNodeRelaxation
+        (
+            labelHashSet &tP,
+            const scalarList &r,
+            const relaxationKind kind,
+            labelHashSet* stuck = NULL,
+            Map<point>* previous = NULL
+        );
+
+        // Line search along the quality gradient of the worst cell of each
+        // point, as long as the worst cell around the point improves
+        void localOptimisation(const labelHashSet& pts);
+
+        // Laplace reset and Jacobi Laplace of the points, each point only
+        // writes its own moved point and the loops run in parallel
+        void laplaceReset(const labelList& pts);
+        void laplaceSmooth(const labelList& pts);
+        void featLaplaceSmooth(const labelList& pts);
+
+        // Multicolour schedule: colour the cells, transform the cells of a
+        // colour and return their points, smooth colour by colour
+        void colourCells();
+        labelHashSet transformColour(const labelList& cells);
+        void GETMeMulticolour();
+
+        // Adaptive transformation parameter: store the qualities before
+        // the transformation, then shrink the parameter of the transformed
+        // cells which lost quality or needed relaxation and grow the others
+        void storeQuality();
+        void adaptTransformParameter(const labelList& cells);
+
+        // Sequential min cycle: transform the worst cell and update its
+        // neighbours, as many times as there are cells below the treshold
+        void GETMeSequential();
+
+        // Extrapolate the interior points from the last iterates, the step
+        // is undone if the mean or the min quality drops
+        void andersonStep();
 
         // Run one iteration
         bool runIteration();
@@ -85,18 +190,23 @@ class MeshSmoother
 
         // Smoothing algo
         void GETMeSmoothing();
+        void optimisationSmoothing();
         void snapSmoothing();
 
 public:
 
     //- Constructors
 
-        //- Construct from polyMesh and dictionary
+        //- Construct from polyMesh and dictionary, the snapping surfaces
+        //  are shared with the other smoothers using the same surfCache.
+        //  maxThreads > 0 caps the threads of the point loops
         MeshSmoother
         (
             polyMesh *mesh,
             dictionary *smootherDict,
-            blockMesh *blocks = 0
+            blockMesh *blocks = 0,
+            SmootherSurfaceCache* surfCache = 0,
+            const label maxThreads = 0
         );
 
     //- Destructor
@@ -118,6 +228,29 @@ public:
 
         // Get tranformation treshold
         scalar getTransformationTreshold() const;
+
+        // Mean ratio quality of the cells
+        scalarField cellQuality() const;
+
+        // Number of iterations run
+        label nbIterations() const;
+
+        // Regions of the case with constant/<region>/polyMesh/meshFile,
+        // the default region included
+        static wordList findRegions(const Time& runTime, const word& meshFile);
+
+        // Share of a budget of nThreads threads, all the available threads
+        // if nThreads < 1, given to each of nRegions smoothers
+        static label regionThreads(const label nThreads, const label nRegions);
+
+        // Smooth the meshes concurrently on nThreads threads, all the
+        // available threads if nThreads < 1. The smoothers are built with
+        // regionThreads threads each, the status is printed per mesh
+        static void updateAll
+        (
+            PtrList<MeshSmoother>& smoothers,
+            const label nThreads
+        );
 };
 
 // * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * //
@@ -22,6 +22,8 @@ License
 
 #include "SmootherEdge.h"
 
+#include "polyMesh.H"
+
 #include "SmootherBoundary.h"
 
 // * * * * * * * * * * * * * * * Private Functions * * * * * * * * * * * * * //
@@ -41,20 +43,20 @@ Foam::SmootherEdge::SmootherEdge
 
 // * * * * * * * * * * * * * * * Member Functions  * * * * * * * * * * * * * //
 
-void Foam::SmootherEdge::GETMeSmooth()
+void Foam::SmootherEdge::GETMeSmooth(const SmootherBoundary& bnd)
 {
-    SmootherPoint::GETMeSmooth();
-    _movedPt = _bnd->snapToEdge(_featureRef, _movedPt);
+    SmootherPoint::GETMeSmooth(bnd);
+    _movedPt = bnd.snapToEdge(_featureRef, _movedPt);
 }
 
-void SmootherEdge::snap()
+void SmootherEdge::snap(const SmootherBoundary& bnd)
 {
-//    const labelList& pp = _polyMesh->pointPoints(_ptRef);
+//    const labelList& pp = bnd.mesh().pointPoints()[_ptRef];
 //    label nbPt = 0;
 //    _movedPt = point(0.0, 0.0, 0.0);
 //    forAll(pp, ptI)
 //    {
-//        if (_bnd->pt(pp[ptI])->isEdge())
+//        if (bnd.pt(pp[ptI])->isEdge())
 //        {
 //            _movedPt += _bnd->pt(pp[ptI])->getInitialPoint();
 //            ++nbPt;
@@ -62,25 +64,30 @@ void SmootherEdge::snap()
 //    }
 //    _movedPt /= nbPt;
 
-//    _movedPt = _bnd->snapToEdge(_featureRef, _movedPt);
-    _movedPt = _bnd->snapToEdge(_featureRef, _initialPt);
+//    _movedPt = bnd.snapToEdge(_featureRef, _movedPt);
+    _movedPt = bnd.snapToEdge(_featureRef, getInitialPoint());
 }
 
-void SmootherEdge::featLaplaceSmooth()
+void SmootherEdge::featLaplaceSmooth(const SmootherBoundary& bnd)
 {
-    const labelList& pp = _polyMesh->pointPoints(_ptRef);
-    label nbPt = 0;
+    const labelUList nei = bnd.featureNeighbours(_ptRef);
     _movedPt = point(0.0, 0.0, 0.0);
-    forAll(pp, ptI)
+    forAll(nei, ptI)
     {
-        if (_bnd->pt(pp[ptI])->isEdge())
-        {
-            _movedPt += _bnd->pt(pp[ptI])->getRelaxedPoint();
-            ++nbPt;
-        }
+        _movedPt += bnd.pt(nei[ptI])->getRelaxedPoint();
     }
 
-    _movedPt /= nbPt;
+    _movedPt /= nei.size();
+}
+
+Foam::vector Foam::SmootherEdge::tangent
+(
+    const SmootherBoundary& bnd,
+    const vector& d
+) const
+{
+    const vector t = bnd.edgeDirection(_featureRef, getRelaxedPoint());
+    return (d & t)*t;
 }
 
 // * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * //
@@ -42,11 +42,15 @@ class SmootherEdge
 public:
     SmootherEdge(const label ref, const label featureRef, const point &pt);
 
-    void GETMeSmooth();
-    void snap();
-    void featLaplaceSmooth();
+    void GETMeSmooth(const SmootherBoundary& bnd);
+    void snap(const SmootherBoundary& bnd);
+    void featLaplaceSmooth(const SmootherBoundary& bnd);
+    vector tangent(const SmootherBoundary& bnd, const vector& d) const;
     bool isEdge() const {return true;}
     bool isSurface() const {return true;}
+
+    // Nearest point query in the edge octree
+    label costHint() const {return 20;}
 };
 
 // * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * //
@@ -57,14 +57,14 @@ public:
 
     ~SmootherFeature() {}
 
-    inline void needSnap();
+    inline void needSnap(SmootherBoundary& bnd);
 };
 
-void SmootherFeature::needSnap()
+void SmootherFeature::needSnap(SmootherBoundary& bnd)
 {
     if (_relaxLevel == 0)
     {
-        _bnd->removeSnapPoint(_ptRef);
+        bnd.removeSnapPoint(_ptRef);
     }
 }
 
@@ -43,31 +43,36 @@ Foam::SmootherSurface::SmootherSurface
 
 // * * * * * * * * * * * * * * * Member Functions  * * * * * * * * * * * * * //
 
-void Foam::SmootherSurface::GETMeSmooth()
+void Foam::SmootherSurface::GETMeSmooth(const SmootherBoundary& bnd)
 {
-    SmootherPoint::GETMeSmooth();
-    _movedPt = _bnd->snapToSurf(_featureRef, _movedPt);
+    SmootherPoint::GETMeSmooth(bnd);
+    _movedPt = bnd.snapToSurf(_featureRef, _movedPt);
 }
 
-void SmootherSurface::snap()
+void SmootherSurface::snap(const SmootherBoundary& bnd)
 {
-    _movedPt = _bnd->snapToSurf(_featureRef, _initialPt);
+    _movedPt = bnd.snapToSurf(_featureRef, getInitialPoint());
 }
 
-void SmootherSurface::featLaplaceSmooth()
+void SmootherSurface::featLaplaceSmooth(const SmootherBoundary& bnd)
 {
-    const labelList& pp = _polyMesh->pointPoints(_ptRef);
-    label nbPt = 0;
+    const labelUList nei = bnd.featureNeighbours(_ptRef);
     _movedPt = point(0.0, 0.0, 0.0);
-    forAll(pp, ptI)
+    forAll(nei, ptI)
     {
-        if (_bnd->pt(pp[ptI])->isSurface())
-        {
-            _movedPt += _bnd->pt(pp[ptI])->getRelaxedPoint();
-            ++nbPt;
-        }
+        _movedPt += bnd.pt(nei[ptI])->getRelaxedPoint();
     }
-    _movedPt /= nbPt;
+    _movedPt /= nei.size();
+}
+
+Foam::vector Foam::SmootherSurface::tangent
+(
+    const SmootherBoundary& bnd,
+    const vector& d
+) const
+{
+    const vector n = bnd.surfNormal(_featureRef, getRelaxedPoint());
+    return d - (d & n)*n;
 }
 
 // * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * //
@@ -41,10 +41,14 @@ class SmootherSurface
 public:
     SmootherSurface(const label ref, const label featureRef, const point &pt);
 
-    void GETMeSmooth();
-    void snap();
-    void featLaplaceSmooth();
+    void GETMeSmooth(const SmootherBoundary& bnd);
+    void snap(const SmootherBoundary& bnd);
+    void featLaplaceSmooth(const SmootherBoundary& bnd);
+    vector tangent(const SmootherBoundary& bnd, const vector& d) const;
     bool isSurface() const {return true;}
+
+    // Nearest point query in the triangle octree
+    label costHint() const {return 50;}
 };
 
 // * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * //
@@ -24,52 +24,37 @@ License
 
 #include "polyMesh.H"
 
-#include "SmootherParameter.h"
 #include "SmootherBoundary.h"
 
-// * * * * * * * * * * * * * * Static Data Members * * * * * * * * * * * * * //
-
-namespace Foam
-{
-    polyMesh* SmootherPoint::_polyMesh = NULL;
-    SmootherBoundary* SmootherPoint::_bnd = NULL;
-    SmootherParameter* SmootherPoint::_param = NULL;
-}
-
 // * * * * * * * * * * * * * * * * Constructors  * * * * * * * * * * * * * * //
 
 Foam::SmootherPoint::SmootherPoint(const label ref, const point &pt)
 :
-    _relaxedPt(pt),
+    _relaxedPt(storePoint(pt)),
+    _relaxLevel(0),
+    _relaxMemory(0),
+    _relaxedPastStart(false),
     _ptRef(ref)
 {
 }
 
 Foam::SmootherPoint::SmootherPoint()
+:
+    _relaxLevel(0),
+    _relaxMemory(0),
+    _relaxedPastStart(false)
 {
 }
 
 // * * * * * * * * * * * * * * * Member Functions  * * * * * * * * * * * * * //
 
-void Foam::SmootherPoint::setStaticItems
-(
-    SmootherBoundary *bnd,
-    SmootherParameter *param,
-    polyMesh *mesh
-)
-{
-    _bnd = bnd;
-    _param = param;
-    _polyMesh = mesh;
-}
-
-void SmootherPoint::laplaceSmooth()
+void SmootherPoint::laplaceSmooth(const SmootherBoundary& bnd)
 {
-    const labelList& pp = _polyMesh->pointPoints(_ptRef);
+    const labelList& pp = bnd.mesh().pointPoints()[_ptRef];
     _movedPt = point(0.0, 0.0, 0.0);
     forAll(pp, ptI)
     {
-        _movedPt += _bnd->pt(pp[ptI])->getInitialPoint();
+        _movedPt += bnd.pt(pp[ptI])->getInitialPoint();
     }
     _movedPt /= pp.size();
 }
@@ -24,6 +24,7 @@ License
 #define MESHSMOOTHERPOINT_H
 
 #include "MeshSmoother.h"
+#include "SmootherPrecision.h"
 
 // * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * //
 
@@ -42,23 +43,25 @@ protected:
 
     //- Protected data
 
-        // Pointers
-        static polyMesh* _polyMesh;
-        static SmootherBoundary* _bnd;
-        static SmootherParameter* _param;
-
-        // Point storage
-        point _initialPt; // Point before iteration
-        point _movedPt;   // Moved point without relaxation
-        point _relaxedPt; // Relaxed point
+        // Point storage, the moved point accumulates the GETMe weighted
+        // sum and is always kept in double precision
+        storedPoint _initialPt; // Point before iteration
+        point _movedPt;         // Moved point without relaxation
+        storedPoint _relaxedPt; // Relaxed point
 
         // Scalar stored in points
-        scalar _averageQuality;
+        storedScalar _averageQuality;
         scalar _weightingFactor;
 
         // Relaxation level
         label _relaxLevel;
 
+        // Relaxation level the next GETMe relaxation starts from
+        label _relaxMemory;
+
+        // Has the point been relaxed past the level it started from
+        bool _relaxedPastStart;
+
         // PolyMesh point ref
         label _ptRef;
 
@@ -76,17 +79,9 @@ public:
 
     //- Member functions
 
-        // Set boundary and control ref
-        void setStaticItems
-        (
-            SmootherBoundary *bnd,
-            SmootherParameter *param,
-            polyMesh* mesh
-        );
-
         // Set/get and reset quality
         void setQuality(const scalar &qual) {_averageQuality = qual;}
-        const scalar &avgQual() const {return _averageQuality;}
+        scalar avgQual() const {return _averageQuality;}
 
         // Reset point
         inline void GETMeReset();
@@ -99,22 +94,57 @@ public:
 
         // Get points
         const point& getMovedPoint() const {return _movedPt;}
-        const point& getRelaxedPoint() const {return _relaxedPt;}
-        const point& getInitialPoint() const {return _initialPt;}
-
-        // Move point
-        virtual void GETMeSmooth() {_movedPt /= _weightingFactor;}
-        virtual void laplaceSmooth();
-        virtual void snap() {}
-        virtual void featLaplaceSmooth() {}
+        point getRelaxedPoint() const {return loadPoint(_relaxedPt);}
+        point getInitialPoint() const {return loadPoint(_initialPt);}
+
+        // Set point position
+        inline void resetPoint(const point& pt);
+
+        // Move point, the boundary of the smoother owning the point gives
+        // the mesh addressing and the snapping surfaces
+        virtual void GETMeSmooth(const SmootherBoundary&)
+        {
+            _movedPt /= _weightingFactor;
+        }
+        virtual void laplaceSmooth(const SmootherBoundary& bnd);
+        virtual void snap(const SmootherBoundary&) {}
+        virtual void featLaplaceSmooth(const SmootherBoundary&) {}
 
         // Get information about point
-        virtual void needSnap(){}
+        virtual void needSnap(SmootherBoundary&) {}
         virtual bool isSurface() const {return false;}
         virtual bool isEdge() const {return false;}
+        virtual bool isFixed() const {return false;}
+
+        // Part of the displacement d the point can follow, in the tangent
+        // plane or along the edge of its feature
+        virtual vector tangent(const SmootherBoundary&, const vector& d) const
+        {
+            return d;
+        }
+
+        // Relative cost of a snap or GETMe update of the point
+        virtual label costHint() const {return 1;}
 
         // Set and reset relaxation level
-        void resetRelaxationLevel() {_relaxLevel = 0;}
+        void resetRelaxationLevel()
+        {
+            _relaxLevel = 0;
+            _relaxedPastStart = false;
+        }
+        label relaxLevel() const {return _relaxLevel;}
+        bool relaxedPastStart() const {return _relaxedPastStart;}
+
+        // Start from the remembered level, never the level putting the
+        // point back, and remember the level used one level closer to the
+        // full step
+        void recallRelaxationLevel(const scalarList& r)
+        {
+            _relaxLevel = max(min(_relaxMemory, r.size() - 2), 0);
+            _relaxedPastStart = false;
+        }
+        void storeRelaxationLevel() {_relaxMemory = max(_relaxLevel - 1, 0);}
+        void forgetRelaxationLevel() {_relaxMemory = 0;}
         inline void addRelaxLevel(const scalarList& r);
 
         // Compute relaxed point
@@ -126,6 +156,7 @@ void SmootherPoint::GETMeReset()
     _weightingFactor = 0.0;
     _movedPt = point(0.0, 0.0, 0.0);
     _initialPt = _relaxedPt;
+    _relaxedPastStart = false;
 }
 
 void SmootherPoint::laplaceReset()
@@ -142,11 +173,18 @@ void SmootherPoint::addWeight(const scalar &wei, const point &pt)
 void SmootherPoint::addWeight(const scalar& wei)
 {
     _weightingFactor += wei;
-    _movedPt += wei*_initialPt;
+    _movedPt += wei*loadPoint(_initialPt);
+}
+
+void SmootherPoint::resetPoint(const point& pt)
+{
+    _initialPt = storePoint(pt);
+    _relaxedPt = _initialPt;
 }
 
 void SmootherPoint::addRelaxLevel(const scalarList &r)
 {
+    _relaxedPastStart = true;
     if ((_relaxLevel + 1) < r.size())
     {
         ++_relaxLevel;
@@ -155,7 +193,11 @@ void SmootherPoint::addRelaxLevel(const scalarList &r)
 
 void SmootherPoint::relaxPoint(const scalarList &r)
 {
-    _relaxedPt = (1.0 - r[_relaxLevel])*_initialPt + r[_relaxLevel]*_movedPt;
+    _relaxedPt = storePoint
+    (
+        (1.0 - r[_relaxLevel])*loadPoint(_initialPt)
+      + r[_relaxLevel]*_movedPt
+    );
 }
 
 // * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * //
@@ -42,12 +42,17 @@ class SmootherVertex
 public:
     SmootherVertex(const label ref, const point &pt);
 
-    void GETMeSmooth() {_movedPt = _initialPt;}
-    void snap(){_movedPt = _initialPt;}
-    void laplaceSmooth() {}
+    void GETMeSmooth(const SmootherBoundary&) {_movedPt = getInitialPoint();}
+    void snap(const SmootherBoundary&) {_movedPt = getInitialPoint();}
+    void laplaceSmooth(const SmootherBoundary&) {}
+    vector tangent(const SmootherBoundary&, const vector&) const
+    {
+        return vector::zero;
+    }
 
     bool isEdge() const {return true;}
     bool isSurface() const {return true;}
+    bool isFixed() const {return true;}
 };
 
 // * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * //
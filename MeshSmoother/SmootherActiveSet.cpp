@@ -0,0 +1,199 @@
+/*---------------------------------------------------------------------------*\
+  extBlockMesh
+  Copyright (C) 2014 Etudes-NG
+  ---------------------------------
+License
+    This file is part of extBlockMesh.
+
+    extBlockMesh is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    extBlockMesh is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+    FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+    for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with extBlockMesh.  If not, see <http://www.gnu.org/licenses/>.
+
+\*---------------------------------------------------------------------------*/
+
+#include "SmootherActiveSet.h"
+
+#include "polyMesh.H"
+#include "SortableList.H"
+
+#include "SmootherCell.h"
+
+// * * * * * * * * * * * * * * * Private Functions * * * * * * * * * * * * * //
+
+void Foam::SmootherActiveSet::rebuild
+(
+    const SmootherPool<SmootherCell>& cell,
+    const scalar treshold
+)
+{
+    _treshold = treshold;
+    _cells.clear();
+    _frozen = false;
+    _noImprove = 0;
+
+    forAll(_cellSlot, cellI)
+    {
+        const scalar cQ = cell[_cellSlot[cellI]].quality();
+        if (cQ <= _treshold)
+        {
+            _cells.insert(cellI);
+            _bestQuality[cellI] = cQ;
+        }
+    }
+}
+
+// * * * * * * * * * * * * * * * * Constructors  * * * * * * * * * * * * * * //
+
+Foam::SmootherActiveSet::SmootherActiveSet
+(
+    const polyMesh* mesh,
+    const labelList& cellSlot,
+    const bool enabled,
+    const label haloLayers,
+    const label maxNoImprove
+)
+:
+    _polyMesh(mesh),
+    _cellSlot(cellSlot),
+    _enabled(enabled),
+    // One layer at least, the relaxation pulls in the points of the
+    // invalid cells around the moved points
+    _haloLayers(max(haloLayers, 1)),
+    _maxNoImprove(maxNoImprove),
+    _treshold(-1.0),
+    _minCycle(-1)
+{
+    if (_enabled)
+    {
+        _bestQuality.setSize(_polyMesh->nCells(), 0.0);
+        _noImprove.setSize(_polyMesh->nCells(), 0);
+        _frozen.setSize(_polyMesh->nCells(), false);
+    }
+}
+
+// * * * * * * * * * * * * * * * Member Functions  * * * * * * * * * * * * * //
+
+void Foam::SmootherActiveSet::update
+(
+    const SmootherPool<SmootherCell>& cell,
+    const scalar treshold,
+    const label minCycle
+)
+{
+    if (minCycle != _minCycle)
+    { // New min cycle
+
+        _minCycle = minCycle;
+        rebuild(cell, treshold);
+    }
+    else
+    {
+        // Cells leaving or entering the set
+        forAllConstIter(labelHashSet, _changedCells, iter)
+        {
+            const label cellI = iter.key();
+            const scalar cQ = cell[_cellSlot[cellI]].quality();
+
+            if (cQ > _treshold)
+            {
+                _cells.erase(cellI);
+            }
+            else if (!_frozen[cellI] && !_cells.found(cellI))
+            {
+                _cells.insert(cellI);
+                _bestQuality[cellI] = cQ;
+                _noImprove[cellI] = 0;
+            }
+        }
+
+        // Drop the cells which stopped improving
+        DynamicList<label> stalled;
+        forAllConstIter(labelHashSet, _cells, iter)
+        {
+            const label cellI = iter.key();
+            const scalar cQ = cell[_cellSlot[cellI]].quality();
+
+            if (cQ > _bestQuality[cellI] + SMALL)
+            {
+                _bestQuality[cellI] = cQ;
+                _noImprove[cellI] = 0;
+            }
+            else if (++_noImprove[cellI] > _maxNoImprove)
+            {
+                stalled.append(cellI);
+            }
+        }
+
+        forAll(stalled, cellI)
+        {
+            _frozen[stalled[cellI]] = true;
+            _cells.erase(stalled[cellI]);
+        }
+    }
+
+    _changedCells.clear();
+}
+
+Foam::labelList Foam::SmootherActiveSet::sweepOrder
+(
+    const labelHashSet& cells
+) const
+{
+    // Sorted on the table slots to sum the GETMe weights in the same order
+    // as a full sweep, which follows the renumbering
+    const labelList c(cells.toc());
+    SortableList<label> slots(c.size());
+    forAll(c, cellI)
+    {
+        slots[cellI] = _cellSlot[c[cellI]];
+    }
+    slots.sort();
+
+    labelList order(c.size());
+    forAll(order, cellI)
+    {
+        order[cellI] = c[slots.indices()[cellI]];
+    }
+    return order;
+}
+
+Foam::labelList Foam::SmootherActiveSet::haloPoints() const
+{
+    const labelListList& cellPoints = _polyMesh->cellPoints();
+    const labelListList& pointCells = _polyMesh->pointCells();
+
+    labelHashSet pts;
+    forAllConstIter(labelHashSet, _cells, iter)
+    {
+        pts.insert(cellPoints[iter.key()]);
+    }
+
+    for (label layer = 0; layer < _haloLayers; ++layer)
+    {
+        labelHashSet ring;
+        forAllConstIter(labelHashSet, pts, iter)
+        {
+            const labelList& pC = pointCells[iter.key()];
+            forAll(pC, cellI)
+            {
+                ring.insert(cellPoints[pC[cellI]]);
+            }
+        }
+        pts |= ring;
+    }
+
+    return pts.toc();
+}
+
+// * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * //
+
+// ************************************************************************* //
@@ -0,0 +1,136 @@
+/*---------------------------------------------------------------------------*\
+  extBlockMesh
+  Copyright (C) 2014 Etudes-NG
+  ---------------------------------
+License
+    This file is part of extBlockMesh.
+
+    extBlockMesh is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    extBlockMesh is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+    FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+    for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with extBlockMesh.  If not, see <http://www.gnu.org/licenses/>.
+
+\*---------------------------------------------------------------------------*/
+
+#ifndef SMOOTHERACTIVESET_H
+#define SMOOTHERACTIVESET_H
+
+#include "HashSet.H"
+#include "boolList.H"
+#include "scalarList.H"
+
+#include "SmootherPool.h"
+
+// * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * //
+
+namespace Foam
+{
+class polyMesh;
+class SmootherCell;
+
+/*---------------------------------------------------------------------------*\
+                     Class SmootherActiveSet Declaration
+\*---------------------------------------------------------------------------*/
+
+class SmootherActiveSet
+{
+    //- Private data
+
+        // Pointer of parent
+        const polyMesh* _polyMesh;
+
+        // Slot of each mesh cell in the smoother cell table
+        const labelList& _cellSlot;
+
+        // Inputs
+        bool _enabled;
+        label _haloLayers;
+        label _maxNoImprove;
+
+        // Treshold and min cycle used to build the set
+        scalar _treshold;
+        label _minCycle;
+
+        // Cells below the treshold still improving
+        labelHashSet _cells;
+
+        // Cells whose quality changed since the last update
+        labelHashSet _changedCells;
+
+        // Best quality and number of iterations without improvement
+        scalarList _bestQuality;
+        labelList _noImprove;
+        boolList _frozen;
+
+    //- Private member functions
+
+        // Rebuild the set from all the cells of the mesh
+        void rebuild
+        (
+            const SmootherPool<SmootherCell>& cell,
+            const scalar treshold
+        );
+
+public:
+
+    //- Constructors
+
+        //- Construct from polyMesh, cell table slots and smoothControls
+        //  settings
+        SmootherActiveSet
+        (
+            const polyMesh* mesh,
+            const labelList& cellSlot,
+            const bool enabled,
+            const label haloLayers,
+            const label maxNoImprove
+        );
+
+    //- Member functions
+
+        // Is the active set used during min cycles
+        bool enabled() const {return _enabled;}
+
+        // Mark cells whose quality has been recomputed
+        void markChanged(const labelHashSet& cells) {_changedCells |= cells;}
+        const labelHashSet& changedCells() const {return _changedCells;}
+
+        // Update the set with the changed cells, drop the stalled cells.
+        // The set is rebuilt when a new min cycle starts
+        void update
+        (
+            const SmootherPool<SmootherCell>& cell,
+            const scalar treshold,
+            const label minCycle
+        );
+
+        // Cells in the order of a full sweep of the cell table
+        labelList sweepOrder(const labelHashSet& cells) const;
+
+        // Active cells in the order of a full sweep
+        labelList cells() const {return sweepOrder(_cells);}
+
+        // Points of the active cells and of their halo layers
+        labelList haloPoints() const;
+
+        // Number of active cells
+        label size() const {return _cells.size();}
+};
+
+// * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * //
+
+} // End namespace Foam
+
+// * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * //
+
+#endif // SMOOTHERACTIVESET_H
+
+// ************************************************************************* //
@@ -0,0 +1,252 @@
+/*---------------------------------------------------------------------------*\
+  extBlockMesh
+  Copyright (C) 2014 Etudes-NG
+  ---------------------------------
+License
+    This file is part of extBlockMesh.
+
+    extBlockMesh is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    extBlockMesh is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+    FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+    for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with extBlockMesh.  If not, see <http://www.gnu.org/licenses/>.
+
+\*---------------------------------------------------------------------------*/
+
+#include "SmootherAnderson.h"
+
+#include "scalarMatrices.H"
+
+#include "SmootherBoundary.h"
+#include "SmootherKernel.h"
+#include "SmootherPoint.h"
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+// * * * * * * * * * * * * * * * Local Functions * * * * * * * * * * * * * * //
+
+namespace Foam
+{
+    inline floatVector toFloat(const point& pt)
+    {
+        return floatVector(pt.x(), pt.y(), pt.z());
+    }
+
+    inline vector toDouble(const floatVector& v)
+    {
+        return vector(v.x(), v.y(), v.z());
+    }
+}
+
+// * * * * * * * * * * * * * * * Private Functions * * * * * * * * * * * * * //
+
+inline Foam::vector Foam::SmootherAnderson::residualDifference
+(
+    const label a,
+    const label i
+) const
+{
+    return toDouble(_f[entry(a + 1)][i]) - toDouble(_f[entry(a)][i]);
+}
+
+// * * * * * * * * * * * * * * * * Constructors  * * * * * * * * * * * * * * //
+
+Foam::SmootherAnderson::SmootherAnderson
+(
+    const labelList& pts,
+    const label depth,
+    const label nThreads,
+    const bool deterministic
+)
+:
+    _pts(pts),
+    _depth(max(depth, 1)),
+    _nThreads(nThreads),
+    _deterministic(deterministic),
+    _dG(_depth + 1, List<floatVector>(pts.size())),
+    _f(_depth + 1, List<floatVector>(pts.size())),
+    _x(pts.size(), vector::zero),
+    _gLast(pts.size(), vector::zero),
+    _size(0),
+    _last(0)
+{
+}
+
+// * * * * * * * * * * * * * * * Member Functions  * * * * * * * * * * * * * //
+
+void Foam::SmootherAnderson::begin(const SmootherBoundary& bnd)
+{
+    const label n = _pts.size();
+
+    #pragma omp parallel for schedule(static) num_threads(_nThreads)
+    for (label i = 0; i < n; ++i)
+    {
+        _x[i] = bnd.pt(_pts[i])->getRelaxedPoint();
+    }
+}
+
+bool Foam::SmootherAnderson::extrapolate(const SmootherBoundary& bnd)
+{
+    const label n = _pts.size();
+
+    _last = (_last + 1) % _f.size();
+    _size = min(_size + 1, _f.size());
+
+    List<floatVector>& dGk = _dG[_last];
+    List<floatVector>& fk = _f[_last];
+
+    #pragma omp parallel for schedule(static) num_threads(_nThreads)
+    for (label i = 0; i < n; ++i)
+    {
+        const point g = bnd.pt(_pts[i])->getRelaxedPoint();
+        dGk[i] = toFloat(g - _gLast[i]);
+        fk[i] = toFloat(g - _x[i]);
+        _gLast[i] = g;
+    }
+
+    if (_size < 2)
+    {
+        return false;
+    }
+
+    // Normal equations of the residual differences, lower triangle
+    const label m = _size - 1;
+    scalarSquareMatrix A(m, m, 0.0);
+    scalarField gamma(m, 0.0);
+
+    if (_deterministic)
+    { // Each entry computed per point and summed by blocks
+
+        scalarField v(n);
+        for (label a = 0; a < m; ++a)
+        {
+            for (label b = 0; b <= a; ++b)
+            {
+                #pragma omp parallel for schedule(static) num_threads(_nThreads)
+                for (label i = 0; i < n; ++i)
+                {
+                    v[i] = residualDifference(a, i) & residualDifference(b, i);
+                }
+                A[a][b] = SmootherKernel::deterministicSum
+                (
+                    v.cdata(),
+                    n,
+                    _nThreads
+                );
+            }
+
+            #pragma omp parallel for schedule(static) num_threads(_nThreads)
+            for (label i = 0; i < n; ++i)
+            {
+                v[i] = residualDifference(a, i) & toDouble(fk[i]);
+            }
+            gamma[a] = SmootherKernel::deterministicSum
+            (
+                v.cdata(),
+                n,
+                _nThreads
+            );
+        }
+    }
+    else
+    { // Summed per thread and added in thread order
+
+        List<scalarList> partial(_nThreads, scalarList(m*m + m, 0.0));
+
+        #pragma omp parallel num_threads(_nThreads)
+        {
+#ifdef _OPENMP
+            scalarList& s = partial[omp_get_thread_num()];
+#else
+            scalarList& s = partial[0];
+#endif
+            List<vector> dF(m);
+
+            #pragma omp for schedule(static)
+            for (label i = 0; i < n; ++i)
+            {
+                for (label a = 0; a < m; ++a)
+                {
+                    dF[a] = residualDifference(a, i);
+                }
+
+                const vector f = toDouble(fk[i]);
+                for (label a = 0; a < m; ++a)
+                {
+                    s[m*m + a] += dF[a] & f;
+                    for (label b = 0; b <= a; ++b)
+                    {
+                        s[a*m + b] += dF[a] & dF[b];
+                    }
+                }
+            }
+        }
+
+        forAll(partial, threadI)
+        {
+            for (label a = 0; a < m; ++a)
+            {
+                gamma[a] += partial[threadI][m*m + a];
+                for (label b = 0; b <= a; ++b)
+                {
+                    A[a][b] += partial[threadI][a*m + b];
+                }
+            }
+        }
+    }
+
+    scalar trace = 0.0;
+    for (label a = 0; a < m; ++a)
+    {
+        trace += A[a][a];
+        for (label b = 0; b < a; ++b)
+        {
+            A[b][a] = A[a][b];
+        }
+    }
+
+    if (trace < VSMALL)
+    { // Points did not move
+
+        return false;
+    }
+
+    // Small Tikhonov term for nearly collinear residuals
+    for (label a = 0; a < m; ++a)
+    {
+        A[a][a] += 1e-10*trace;
+    }
+    LUsolve(A, gamma);
+
+    // Extrapolated points x = g - sum(gamma dG), from the iterate in full
+    // precision
+    #pragma omp parallel for schedule(static) num_threads(_nThreads)
+    for (label i = 0; i < n; ++i)
+    {
+        point x = _gLast[i];
+        for (label a = 0; a < m; ++a)
+        {
+            x -= gamma[a]*toDouble(_dG[entry(a + 1)][i]);
+        }
+
+        SmootherPoint* pt = bnd.pt(_pts[i]);
+        pt->GETMeReset();
+        pt->addWeight(1.0, x);
+        pt->GETMeSmooth(bnd);
+    }
+
+    return true;
+}
+
+// * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * //
+
+// ************************************************************************* //
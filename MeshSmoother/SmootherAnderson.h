@@ -0,0 +1,122 @@
+/*---------------------------------------------------------------------------*\
+  extBlockMesh
+  Copyright (C) 2014 Etudes-NG
+  ---------------------------------
+License
+    This file is part of extBlockMesh.
+
+    extBlockMesh is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    extBlockMesh is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+    FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+    for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with extBlockMesh.  If not, see <http://www.gnu.org/licenses/>.
+
+\*---------------------------------------------------------------------------*/
+
+#ifndef SMOOTHERANDERSON_H
+#define SMOOTHERANDERSON_H
+
+#include "labelList.H"
+#include "pointField.H"
+#include "floatVector.H"
+#include "vector.H"
+
+// * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * //
+
+namespace Foam
+{
+class SmootherBoundary;
+
+/*---------------------------------------------------------------------------*\
+                     Class SmootherAnderson Declaration
+\*---------------------------------------------------------------------------*/
+
+// Anderson acceleration of the mean cycle: the GETMe iteration x -> g(x) is
+// seen as a fixed point problem, the differences of the last iterates g and
+// the residuals g - x of the interior points are kept in float and the next
+// points are the combination of the iterates minimising the residual in
+// least squares. Only small differences are rounded, never the points
+class SmootherAnderson
+{
+    //- Private data
+
+        // Interior points of the smoother
+        const labelList& _pts;
+
+        // Number of differences of iterates used by the least squares
+        label _depth;
+
+        // Number of threads of the point loops
+        label _nThreads;
+
+        // Are the normal equations summed with the same bits whatever
+        // the number of threads
+        bool _deterministic;
+
+        // Differences with the previous iterate and residuals, a ring of
+        // depth + 1 entries, the difference of the oldest entry is unused
+        List<List<floatVector> > _dG;
+        List<List<floatVector> > _f;
+
+        // Points before the GETMe step and last iterate
+        pointField _x;
+        pointField _gLast;
+
+        // Number of stored iterates and entry of the last one
+        label _size;
+        label _last;
+
+    //- Private member functions
+
+        // Entry of the i-th stored iterate, 0 the oldest
+        label entry(const label i) const
+        {
+            return (_last + 1 + i + _f.size() - _size) % _f.size();
+        }
+
+        // Difference of the residuals a + 1 and a of point i
+        inline vector residualDifference(const label a, const label i) const;
+
+public:
+
+    //- Constructors
+
+        //- Construct from the interior points and the history depth
+        SmootherAnderson
+        (
+            const labelList& pts,
+            const label depth,
+            const label nThreads,
+            const bool deterministic
+        );
+
+    //- Member functions
+
+        // Forget the iterates, the next extrapolation starts over
+        void clear() {_size = 0;}
+
+        // Store the interior points before the GETMe step
+        void begin(const SmootherBoundary& bnd);
+
+        // Store the iterate of the GETMe step and set the moved point of
+        // the interior points to the extrapolated point, the initial point
+        // being the iterate. False if the history is too short
+        bool extrapolate(const SmootherBoundary& bnd);
+};
+
+// * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * //
+
+} // End namespace Foam
+
+// * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * //
+
+#endif // SMOOTHERANDERSON_H
+
+// ************************************************************************* //
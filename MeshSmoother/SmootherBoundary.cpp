@@ -56,6 +56,7 @@ void Foam::SmootherBoundary::analyseDict(dictionary &snapDict)
     _extEdgMeshList.resize(NbPolyPatchs, 0);
     _bndUseIntEdges.resize(NbPolyPatchs, true);
     _bndIsSnaped.resize(NbPolyPatchs, true);
+    _bndSharedSurface.resize(NbPolyPatchs, false);
     _bndLayers.resize(NbPolyPatchs);
 
     if (snapDict.found("boundaries"))
@@ -86,18 +87,25 @@ void Foam::SmootherBoundary::analyseDict(dictionary &snapDict)
 
                         _bndIsSnaped[patchJ] = false;
 
-                        IOobject surfFile
-                        (
-                            file,
-                            _polyMesh->time().constant(),
-                            "triSurface",
-                            _polyMesh->time(),
-                            IOobject::MUST_READ,
-                            IOobject::NO_WRITE
-                        );
+                        if (_surfCache->found(file))
+                        { // Surface given in memory
 
-                        triSurface* bnd = new triSurface(surfFile.filePath());
-                        addTriFace(patchJ, bnd);
+                            addSharedTriFace(patchJ, file);
+                        }
+                        else
+                        {
+                            IOobject surfFile
+                            (
+                                file,
+                                _polyMesh->time().constant(),
+                                "triSurface",
+                                _polyMesh->time(),
+                                IOobject::MUST_READ,
+                                IOobject::NO_WRITE
+                            );
+
+                            addSharedTriFace(patchJ, surfFile.filePath());
+                        }
 
                         if (patchDic.found("internalFeatureEdges"))
                         {
@@ -253,14 +261,9 @@ void Foam::SmootherBoundary::addTriFace
 )
 {
     _triSurfList[patch] = triSurf;
-    _triSurfSearchList[patch] = new triSurfaceSearch(*triSurf);
-
-    boolList surfBafReg(triSurf->patches().size());
-    const polyBoundaryMesh& pBM = _polyMesh->boundaryMesh();
-    forAll(triSurf->patches(), patchI)
-    {
-        surfBafReg[patchI] = (pBM[patchI].type() == "baffle");
-    }
+    triSurfaceSearch* search = new triSurfaceSearch(*triSurf);
+    search->tree();
+    _triSurfSearchList[patch] = search;
 
     surfaceFeatures* sF = new surfaceFeatures
     (
@@ -271,10 +274,46 @@ void Foam::SmootherBoundary::addTriFace
         false
     );
 
-    _extEdgMeshList[patch] = new extendedEdgeMesh(*sF, surfBafReg);
+    extendedEdgeMesh* eM = new extendedEdgeMesh(*sF, baffleRegions(*triSurf));
+    eM->edgeTree();
+    _extEdgMeshList[patch] = eM;
     _surfFeatList[patch] = sF;
 }
 
+void Foam::SmootherBoundary::addSharedTriFace
+(
+    const label patch,
+    const fileName& file
+)
+{
+    const triSurfaceSearch* search = _surfCache->search(file);
+
+    _triSurfSearchList[patch] = search;
+    _extEdgMeshList[patch] = _surfCache->edges
+    (
+        file,
+        _featureAngle,
+        _minFeatureEdgeLength,
+        _minEdgeForFeature,
+        baffleRegions(search->surface())
+    );
+    _bndSharedSurface[patch] = true;
+}
+
+Foam::boolList Foam::SmootherBoundary::baffleRegions
+(
+    const triSurface& triSurf
+) const
+{
+    boolList surfBafReg(triSurf.patches().size());
+    const polyBoundaryMesh& pBM = _polyMesh->boundaryMesh();
+    forAll(triSurf.patches(), patchI)
+    {
+        surfBafReg[patchI] = (pBM[patchI].type() == "baffle");
+    }
+    return surfBafReg;
+}
+
 Foam::List<Foam::labelledTri> Foam::SmootherBoundary::analyseBoundaryFace
 (
     const label patchI,
@@ -445,7 +484,12 @@ void Foam::SmootherBoundary::markPts
 //    }
 }
 
-void Foam::SmootherBoundary::createPoints(labelList &pointType)
+void Foam::SmootherBoundary::createPoints
+(
+    labelList &pointType,
+    const SmootherStorage* memory,
+    const labelList* pointOrder
+)
 {
     label nbVertex = 0, nbEdge = 0, nbBoundary = 0, nbInterior = 0;
 
@@ -454,13 +498,42 @@ void Foam::SmootherBoundary::createPoints(labelList &pointType)
         if (pointType[ptI] == VERTEX)
         {
             ++nbVertex;
-            _point[ptI] = new SmootherVertex(ptI, _polyMesh->points()[ptI]);
-            _featuresPoint.insert(ptI);
         }
         else if (pointType[ptI] == EDGE)
         {
             ++nbEdge;
-            _point[ptI] = new SmootherEdge
+        }
+        else if (pointType[ptI] == BOUNDARY)
+        {
+            ++nbBoundary;
+        }
+        else if (pointType[ptI] == INTERIOR)
+        {
+            ++nbInterior;
+        }
+    }
+
+    _vertexPool.reserve(nbVertex, memory);
+    _edgePool.reserve(nbEdge, memory);
+    _surfacePool.reserve(nbBoundary, memory);
+    _interiorPool.reserve(nbInterior, memory);
+
+    forAll(pointType, i)
+    {
+        const label ptI = pointOrder ? (*pointOrder)[i] : i;
+
+        if (pointType[ptI] == VERTEX)
+        {
+            _point[ptI] = new(_vertexPool.allocate()) SmootherVertex
+            (
+                ptI,
+                _polyMesh->points()[ptI]
+            );
+            _featuresPoint.insert(ptI);
+        }
+        else if (pointType[ptI] == EDGE)
+        {
+            _point[ptI] = new(_edgePool.allocate()) SmootherEdge
             (
                 ptI,
                 _pointFeature[ptI],
@@ -475,8 +548,7 @@ void Foam::SmootherBoundary::createPoints(labelList &pointType)
         }
         else if (pointType[ptI] == BOUNDARY)
         {
-            ++nbBoundary;
-            _point[ptI] = new SmootherSurface
+            _point[ptI] = new(_surfacePool.allocate()) SmootherSurface
             (
                 ptI,
                 _pointFeature[ptI],
@@ -491,34 +563,125 @@ void Foam::SmootherBoundary::createPoints(labelList &pointType)
         }
         else if (pointType[ptI] == INTERIOR)
         {
-            ++nbInterior;
-            _point[ptI] = new SmootherPoint(ptI, _polyMesh->points()[ptI]);
+            _point[ptI] = new(_interiorPool.allocate()) SmootherPoint
+            (
+                ptI,
+                _polyMesh->points()[ptI]
+            );
             _interiorPoint.insert(ptI);
         }
     }
 
+    // Same points as lists in placement order for the parallel sweeps
+    _interiorPointList.setSize(nbInterior);
+    _featuresPointList.setSize(nbVertex + nbEdge + nbBoundary);
+    label nInterior = 0, nFeatures = 0;
+    forAll(pointType, i)
+    {
+        const label ptI = pointOrder ? (*pointOrder)[i] : i;
+
+        if (pointType[ptI] == INTERIOR)
+        {
+            _interiorPointList[nInterior++] = ptI;
+        }
+        else if
+        (
+            pointType[ptI] == VERTEX
+         || pointType[ptI] == EDGE
+         || pointType[ptI] == BOUNDARY
+        )
+        {
+            _featuresPointList[nFeatures++] = ptI;
+        }
+    }
+
+    buildFeatureNeighbours(pointType);
+
     Info<< "      - Number of feature points:  " << nbVertex << nl
         << "      - Number of edge points:     " << nbEdge << nl
         << "      - Number of boundary points: " << nbBoundary << nl
         << "      - Number of interior points: " << nbInterior << nl << nl;
 }
 
+void Foam::SmootherBoundary::buildFeatureNeighbours
+(
+    const labelList& pointType
+)
+{
+    const labelListList& pointPoints = _polyMesh->pointPoints();
+
+    // Neighbours kept for the points of type EDGE and BOUNDARY
+    boolList edgeNei(pointType.size(), false);
+    boolList surfaceNei(pointType.size(), false);
+    forAll(pointType, ptI)
+    {
+        edgeNei[ptI] =
+            pointType[ptI] == VERTEX || pointType[ptI] == EDGE;
+        surfaceNei[ptI] = edgeNei[ptI] || pointType[ptI] == BOUNDARY;
+    }
+
+    labelList nNei(pointType.size(), 0);
+    forAll(pointType, ptI)
+    {
+        if (pointType[ptI] == EDGE || pointType[ptI] == BOUNDARY)
+        {
+            const boolList& keep =
+                pointType[ptI] == EDGE ? edgeNei : surfaceNei;
+            const labelList& pp = pointPoints[ptI];
+            forAll(pp, ptJ)
+            {
+                nNei[ptI] += keep[pp[ptJ]];
+            }
+        }
+    }
+
+    _featureNeighbours = CompactListList<label>(nNei);
+    forAll(pointType, ptI)
+    {
+        if (nNei[ptI] > 0)
+        {
+            const boolList& keep =
+                pointType[ptI] == EDGE ? edgeNei : surfaceNei;
+            const labelList& pp = pointPoints[ptI];
+            labelUList nei = _featureNeighbours[ptI];
+            label n = 0;
+            forAll(pp, ptJ)
+            {
+                if (keep[pp[ptJ]])
+                {
+                    nei[n++] = pp[ptJ];
+                }
+            }
+        }
+    }
+}
+
 // * * * * * * * * * * * * * * * * Constructors  * * * * * * * * * * * * * * //
 
 Foam::SmootherBoundary::SmootherBoundary
 (
     dictionary &snapDict,
-    polyMesh* mesh
+    polyMesh* mesh,
+    SmootherSurfaceCache* surfCache,
+    const SmootherStorage* memory,
+    const labelList* pointOrder
 )
 :
     _polyMesh(mesh),
+    _surfCache(surfCache),
     _point(List<SmootherPoint*>(_polyMesh->nPoints()))
 {
+    if (!_surfCache)
+    {
+        _ownSurfCache.reset(new SmootherSurfaceCache());
+        _surfCache = _ownSurfCache.operator->();
+    }
+
     analyseDict(snapDict);
     List<labelHashSet> pp(mesh->nPoints());
     std::set<std::set<label> > fP;
     labelList pointType = analyseFeatures(pp, fP);
-    createPoints(pointType);
+    createPoints(pointType, memory, pointOrder);
 
     if (_writeFeatures)
     {
@@ -535,9 +698,13 @@ Foam::SmootherBoundary::~SmootherBoundary()
         delete _triSurfList[trisurfaceI];
     }
 
+    // Shared surfaces are released with their cache
     forAll(_triSurfSearchList, triSurfSearchI)
     {
-        delete _triSurfSearchList[triSurfSearchI];
+        if (!_bndSharedSurface[triSurfSearchI])
+        {
+            delete _triSurfSearchList[triSurfSearchI];
+        }
     }
 
     forAll(_surfFeatList, surfFeatI)
@@ -547,13 +714,13 @@ Foam::SmootherBoundary::~SmootherBoundary()
 
     forAll(_extEdgMeshList, extEdgMeshI)
     {
-        delete _extEdgMeshList[extEdgMeshI];
+        if (!_bndSharedSurface[extEdgMeshI])
+        {
+            delete _extEdgMeshList[extEdgMeshI];
+        }
     }
 
-    forAll(_point, ptI)
-    {
-        delete _point[ptI];
-    }
+    // Points are released with their pools
 }
 
 // * * * * * * * * * * * * * * * Member Functions  * * * * * * * * * * * * * //
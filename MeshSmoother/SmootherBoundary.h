@@ -28,6 +28,7 @@ License
 #include "labelledTri.H"
 #include "point.H"
 #include "HashSet.H"
+#include "CompactListList.H"
 
 #include "extendedEdgeMesh.H"
 #include "triSurfaceMesh.H"
@@ -36,6 +37,8 @@ License
 #include "surfaceFeatures.H"
 
 #include "SmootherBoundaryLayer.h"
+#include "SmootherPool.h"
+#include "SmootherSurfaceCache.h"
 
 #include <map>
 #include <set>
@@ -46,6 +49,10 @@ namespace Foam
 {
 class polyMesh;
 class SmootherPoint;
+class SmootherVertex;
+class SmootherEdge;
+class SmootherSurface;
+class SmootherStorage;
 
 /*---------------------------------------------------------------------------*\
                     Class MeshSmootherBoundary Declaration
@@ -69,17 +76,22 @@ class SmootherBoundary
         // Pointer to polyMesh
         polyMesh* _polyMesh;
 
+        // Surfaces read from files, shared with the other smoothers
+        SmootherSurfaceCache* _surfCache;
+        autoPtr<SmootherSurfaceCache> _ownSurfCache;
+
         // Searchable surfaces list
         List<triSurface*> _triSurfList;
-        List<triSurfaceSearch*> _triSurfSearchList;
+        List<const triSurfaceSearch*> _triSurfSearchList;
 
         // Searchable edge list
         List<surfaceFeatures*> _surfFeatList;
-        List<extendedEdgeMesh*> _extEdgMeshList;
+        List<const extendedEdgeMesh*> _extEdgMeshList;
 
         // Parameter of patch
         boolList _bndUseIntEdges;
         boolList _bndIsSnaped;
+        boolList _bndSharedSurface;
         List<SmootherBoundaryLayer> _bndLayers;
 
         // Point and patch feature ref
@@ -89,10 +101,23 @@ class SmootherBoundary
         // Point as SmootherPoints
         List<SmootherPoint*> _point;
 
+        // Storage of the points grouped by type
+        SmootherPool<SmootherVertex> _vertexPool;
+        SmootherPool<SmootherEdge> _edgePool;
+        SmootherPool<SmootherSurface> _surfacePool;
+        SmootherPool<SmootherPoint> _interiorPool;
+
+        // Neighbours averaged by the feature Laplace of each point: edge
+        // neighbours of the edge points, surface neighbours of the surface
+        // points, none for the other points
+        CompactListList<label> _featureNeighbours;
+
         // Hash set of specific points
         labelHashSet _unsnapedPoint;
         labelHashSet _featuresPoint;
         labelHashSet _interiorPoint;
+        labelList _interiorPointList;
+        labelList _featuresPointList;
 
         // Inputs snapControls
         scalar _featureAngle;
@@ -111,6 +136,10 @@ class SmootherBoundary
         );
 
         void addTriFace(const label patch, triSurface *triSurf);
+        void addSharedTriFace(const label patch, const fileName& file);
+
+        // Surface regions matching a baffle patch
+        boolList baffleRegions(const triSurface& triSurf) const;
 
         List<labelledTri> analyseBoundaryFace
         (
@@ -131,13 +160,30 @@ class SmootherBoundary
             std::set<std::set<label> >& fP
         );
 
-        void createPoints(labelList &pointType);
+        void createPoints
+        (
+            labelList &pointType,
+            const SmootherStorage* memory,
+            const labelList* pointOrder
+        );
+
+        void buildFeatureNeighbours(const labelList& pointType);
 
 public:
 
     //- Constructors
 
-        SmootherBoundary(dictionary& snapDict, polyMesh* mesh);
+        //- Construct from snapControls and polyMesh, surface files are read
+        //  through surfCache, the points placed in memory in pointOrder
+        //  if given
+        SmootherBoundary
+        (
+            dictionary& snapDict,
+            polyMesh* mesh,
+            SmootherSurfaceCache* surfCache = NULL,
+            const SmootherStorage* memory = NULL,
+            const labelList* pointOrder = NULL
+        );
 
     //- Destructor
     ~SmootherBoundary();
@@ -148,13 +194,37 @@ public:
         inline point snapToSurf(const label r, const point &pt) const;
         inline point snapToEdge(const label eRef, const point &pt) const;
 
+        // Unit normal of the surface triangle and unit direction of the
+        // feature edge nearest to pt
+        inline vector surfNormal(const label r, const point &pt) const;
+        inline vector edgeDirection(const label eRef, const point &pt) const;
+
         SmootherPoint* pt(const label p) const {return _point[p];}
 
+        // Neighbours averaged by the feature Laplace of point p
+        const labelUList featureNeighbours(const label p) const
+        {
+            return _featureNeighbours[p];
+        }
+
+        // Mesh of the smoother
+        const polyMesh& mesh() const {return *_polyMesh;}
+
         // Get hash set of specific points
         const labelHashSet& unSnapedPoints() const {return _unsnapedPoint;}
         const labelHashSet& interiorPoints() const {return _interiorPoint;}
         const labelHashSet& featuresPoints() const {return _featuresPoint;}
 
+        // Get the same points as lists in placement order
+        const labelList& interiorPointList() const
+        {
+            return _interiorPointList;
+        }
+        const labelList& featuresPointList() const
+        {
+            return _featuresPointList;
+        }
+
         // Write edges as VTK points
         void writeFeatures
         (
@@ -181,6 +251,27 @@ point SmootherBoundary::snapToEdge(const label eRef, const point &pt) const
     return _extEdgMeshList[eRef]->edgeTree().findNearest(pt, 1e10).hitPoint();
 }
 
+vector SmootherBoundary::surfNormal(const label r, const point &pt) const
+{
+    const indexedOctree<treeDataTriSurface>& t = _triSurfSearchList[r]->tree();
+    const label triI = t.findNearest(pt, 1e10).index();
+
+    // From the triangle, the faceNormals of the surface are demand-driven
+    // The search is set for every surface, shared ones included
+    const triSurface& surf = _triSurfSearchList[r]->surface();
+    const vector n = surf[triI].normal(surf.points());
+    return n/(mag(n) + VSMALL);
+}
+
+vector SmootherBoundary::edgeDirection(const label eRef, const point &pt) const
+{
+    const extendedEdgeMesh& e = *_extEdgMeshList[eRef];
+    const label edgeI = e.edgeTree().findNearest(pt, 1e10).index();
+
+    const vector d = e.edges()[edgeI].vec(e.points());
+    return d/(mag(d) + VSMALL);
+}
+
 // * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * //
 
 } // End namespace Foam
@@ -22,137 +22,89 @@ License
 
 #include "SmootherCell.h"
 
-// * * * * * * * * * * * * * * Static Data Members * * * * * * * * * * * * * //
-
-namespace Foam
-{
-    scalar SmootherCell::_transParam = 1.0;
-    SmootherBoundary* SmootherCell::_bnd = NULL;
-}
-
-// * * * * * * * * * * * * * * * Private Functions * * * * * * * * * * * * * //
+// * * * * * * * * * * * * * * * * Constructors  * * * * * * * * * * * * * * //
 
-Foam::scalar Foam::SmootherCell::tetCellQuality(const label ref) const
+Foam::SmootherCell::SmootherCell()
+:
+    _quality(0.0),
+    _transParam(0.0)
 {
-    const label v1[] = {3, 0, 1, 2, 7, 4, 5, 6};
-    const label v2[] = {4, 5, 6, 7, 5, 6, 7, 4};
-    const label v3[] = {1, 2, 3, 0, 0, 1, 2, 3};
-
-    const Tensor<scalar> mA
-    (
-        relaxPt(v1[ref]) - relaxPt(ref),
-        relaxPt(v2[ref]) - relaxPt(ref),
-        relaxPt(v3[ref]) - relaxPt(ref)
-    );
-    const scalar sigma(det(mA));
-
-    if (sigma > VSMALL)
+    for (label p = 0; p < 8; ++p)
     {
-        // std::pow
-        return 3.0*std::pow(sigma, 2.0/3.0)/magSqr(mA);
-
-        // Faster with fast pow (approx 1/4 less time in mean cycle)
-        // But give inacurracy when mesh is close to orthonormal use with
-        // caution
-// http://martin.ankerl.com/2012/01/25/optimized-approximative-pow-in-c-and-cpp/
-//        return 3.0*fastPow(sigma)/magSqr(mA);
+        _pt[p] = -1;
     }
-
-    return 0.0;
 }
 
-scalar SmootherCell::fastPow(const scalar &s) const
+Foam::SmootherCell::SmootherCell
+(
+    const cellShape &cell,
+    const scalar transParam
+)
+:
+    _quality(0.0),
+    _transParam(transParam)
 {
-    union
+    if (cell.size() != 8)
     {
-        scalar d;
-        label x[2];
-    } u = {s};
-
-    u.x[1] = static_cast<label>(2.0/3.0*(u.x[1] - 1072632447) + 1072632447);
-    u.x[0] = 0;
-    return u.d;
-}
-
-// * * * * * * * * * * * * * * * * Constructors  * * * * * * * * * * * * * * //
+        FatalErrorIn("Foam::SmootherCell::SmootherCell(const cellShape&)")
+            << "Cell " << cell << " is not an hexahedron"
+            << exit(FatalError);
+    }
 
-Foam::SmootherCell::SmootherCell(const cellShape &cell)
-:
-    _cellShape(cell)
-{
+    for (label p = 0; p < 8; ++p)
+    {
+        _pt[p] = int32_t(cell[p]);
+    }
 }
 
 // * * * * * * * * * * * * * * * Member Functions  * * * * * * * * * * * * * //
 
-void Foam::SmootherCell::computeQuality()
+void Foam::SmootherCell::computeQuality(const SmootherBoundary& bnd)
 {
-    _quality = 0.0;
-    forAll(_cellShape, ptI)
+    FixedList<point, 8> pts;
+    forAll(pts, ptI)
     {
-        const scalar tetQuality(tetCellQuality(ptI));
-
-        if (tetQuality < VSMALL)
-        {
-            _quality = 0.0;
-            return;
-        }
-        _quality += tetQuality;
+        pts[ptI] = relaxPt(bnd, ptI);
     }
 
-    _quality /= 8.0;
+    // std::pow, the cbrt and fastPow variants are measured by
+    // smootherBenchmark, fastPow is inaccurate close to orthonormal cells
+    _quality = SmootherKernel::hexQuality(pts, SmootherKernel::STDPOW);
 }
 
-Foam::pointField Foam::SmootherCell::geometricTransform()
+Foam::FixedList<Foam::vector, 8> Foam::SmootherCell::qualityGradient
+(
+    const SmootherBoundary& bnd
+) const
 {
-    // TODO if found a way to have the face label from cellShape,
-    // store face centre in MeshSmoother and avoid use of pointFields dO
-    // faceList fList = cell.faces();
-    // fList[0].centre(pts);
-
-    // Faces centres
-    pointField fc(6);
-    const label f[] = {0, 0, 1, 2, 0, 4};
-    const label g[] = {1, 4, 5, 6, 3, 7};
-    const label h[] = {2, 5, 6, 7, 7, 6};
-    const label i[] = {3, 1, 2, 3, 4, 5};
-    for (label j = 0; j < 6; ++j)
+    FixedList<point, 8> pts;
+    forAll(pts, ptI)
     {
-        fc[j] = (initPt(f[j]) + initPt(g[j]) + initPt(h[j]) + initPt(i[j]))/4.0;
+        pts[ptI] = relaxPt(bnd, ptI);
     }
 
-    // Transfomred points
-    pointField H(8);
-    const label a[] = {0, 0, 0, 0, 5, 5, 5, 5};
-    const label b[] = {1, 2, 3, 4, 4, 1, 2, 3};
-    const label d[] = {4, 1, 2, 3, 1, 2, 3, 4};
-    for (label j = 0; j < 8; ++j)
-    {
-        const point c = (fc[a[j]] + fc[b[j]] + fc[d[j]])/3.0;
-        const point n = (fc[b[j]] - fc[a[j]]) ^ (fc[d[j]] - fc[a[j]]);
-        H[j] = c + _transParam/std::sqrt(mag(n))*n;
-    }
+    FixedList<vector, 8> grad;
+    SmootherKernel::hexQualityGradient(pts, grad);
 
-    // Length scale
-    scalar length = 0.0, lengthN = 0.0;
-    const label k[] = {0, 1, 2, 3, 0, 1, 2, 3, 4, 5, 6, 7};
-    const label l[] = {1, 2, 3, 0, 4, 5, 6, 7, 5, 6, 7, 4};
-    for (label j = 0; j < 12; ++j)
+    return grad;
+}
+
+Foam::FixedList<Foam::point, 8> Foam::SmootherCell::geometricTransform
+(
+    const SmootherBoundary& bnd,
+    const scalar t
+) const
+{
+    FixedList<point, 8> pts;
+    forAll(pts, ptI)
     {
-        length += mag(initPt(k[j]) - initPt(l[j]));
-        lengthN += mag(H[k[j]] - H[l[j]]);
+        pts[ptI] = initPt(bnd, ptI);
     }
-    length /= lengthN;
 
-    const point c = (H[0] + H[1] + H[2] + H[3] + H[4] + H[5] + H[6] + H[7])/8.0;
-    const pointField C(8, c);
+    FixedList<point, 8> H;
+    SmootherKernel::transform(pts, t, H);
 
-    return (C + length*(H - C));
-}
-
-void Foam::SmootherCell::setStaticItems(SmootherBoundary* bnd, const scalar &t)
-{
-    _transParam = t;
-    _bnd = bnd;
+    return H;
 }
 
 // * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * //
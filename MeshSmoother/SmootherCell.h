@@ -26,8 +26,13 @@ License
 #include "cellShape.H"
 #include "polyMesh.H"
 
+#include <limits>
+#include <stdint.h>
+
 #include "SmootherBoundary.h"
+#include "SmootherKernel.h"
 #include "SmootherPoint.h"
+#include "SmootherPrecision.h"
 
 // * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * //
 
@@ -44,58 +49,74 @@ class SmootherCell
 
     //- Private data
 
-        // Pointer of smoother boundary
-        static SmootherBoundary* _bnd;
-
-        // Transformation parameter
-        static scalar _transParam;
+        // Points of the hexahedron, 32 bits indices kept inline in the
+        // cell table instead of a reference to the polyMesh cellShape
+        int32_t _pt[8];
 
         // Cell quality (mean ratio)
-        scalar _quality;
+        storedScalar _quality;
 
-        // Reference of cell shape
-        const cellShape& _cellShape;
+        // Transformation parameter of the cell
+        storedScalar _transParam;
 
     //- Private member functions
 
-        // Tetrahedral quality computation
-        scalar tetCellQuality(const label ref) const;
-
         // get point from cell position
-        inline const point& initPt(const label p) const;
-        inline const point& relaxPt(const label p) const;
-
-        scalar fastPow(const scalar& s) const;
+        inline point initPt(const SmootherBoundary& bnd, const label p) const;
+        inline point relaxPt(const SmootherBoundary& bnd, const label p) const;
 
 public:
 
     //- Constructors
 
-        //- Construct from cellShape
-        SmootherCell(const cellShape& cell);
+        //- Construct null, for the cell table
+        SmootherCell();
+
+        //- Construct from cellShape and transformation parameter
+        SmootherCell(const cellShape& cell, const scalar transParam);
 
 
     //- Member functions
 
-        // Set/get cell quality
-        const scalar& quality() const{return _quality;}
-        void computeQuality();
+        // Mesh point of cell position
+        label pt(const label p) const {return _pt[p];}
 
-        // Transform cell
-        pointField geometricTransform();
+        // Largest number of mesh points the cell can address
+        static label maxPoints()
+        {
+            return std::numeric_limits<int32_t>::max();
+        }
 
-        // Set/get polyMesh
-        void setStaticItems(SmootherBoundary *bnd, const scalar& t);
+        // Set/get cell quality
+        scalar quality() const{return _quality;}
+        void computeQuality(const SmootherBoundary& bnd);
+
+        // Gradient of the quality with respect to the relaxed points
+        FixedList<vector, 8> qualityGradient
+        (
+            const SmootherBoundary& bnd
+        ) const;
+
+        // Set/get transformation parameter
+        scalar transformParameter() const {return _transParam;}
+        void setTransformParameter(const scalar t) {_transParam = t;}
+
+        // Transform cell with the transformation parameter t
+        FixedList<point, 8> geometricTransform
+        (
+            const SmootherBoundary& bnd,
+            const scalar t
+        ) const;
 };
 
-const point &SmootherCell::initPt(const label p) const
+point SmootherCell::initPt(const SmootherBoundary& bnd, const label p) const
 {
-    return _bnd->pt(_cellShape[p])->getInitialPoint();
+    return bnd.pt(_pt[p])->getInitialPoint();
 }
 
-const point &SmootherCell::relaxPt(const label p) const
+point SmootherCell::relaxPt(const SmootherBoundary& bnd, const label p) const
 {
-    return _bnd->pt(_cellShape[p])->getRelaxedPoint();
+    return bnd.pt(_pt[p])->getRelaxedPoint();
 }
 
 // * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * //
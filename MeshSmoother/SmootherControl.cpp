@@ -23,6 +23,7 @@ License
 #include "SmootherControl.h"
 
 #include "dictionary.H"
+#include "Switch.H"
 
 // * * * * * * * * * * * * * * * * Constructors  * * * * * * * * * * * * * * //
 
@@ -38,6 +39,71 @@ Foam::SmootherControl::SmootherControl(dictionary *smootherDict)
     _minRelaxTable = readList<scalar>(smoothDic.lookup("minRelaxationTable"));
     _snapRelaxTable = readList<scalar>(smoothDic.lookup("snapRelaxationTable"));
     _ratioForMin = readScalar(smoothDic.lookup("ratioWorstQualityForMin"));
+    _multiLevels = smoothDic.lookupOrDefault<label>("multiLevels", 0);
+    _multiLevelIter = smoothDic.lookupOrDefault<label>
+    (
+        "multiLevelIterations",
+        20
+    );
+    _activeSet = smoothDic.lookupOrDefault<Switch>("activeSet", false);
+    _activeSetHalo = smoothDic.lookupOrDefault<label>("activeSetHalo", 1);
+    _activeSetMaxNoImprove = smoothDic.lookupOrDefault<label>
+    (
+        "activeSetMaxNoImprove",
+        3
+    );
+    _outOfCore = smoothDic.lookupOrDefault<Switch>("outOfCore", false);
+    _scratchDir = smoothDic.lookupOrDefault<fileName>("scratchDir", "/tmp");
+    _renumbering = smoothDic.lookupOrDefault<word>("renumbering", "none");
+    _nThreads = smoothDic.lookupOrDefault<label>("nThreads", 0);
+    _deterministic = smoothDic.lookupOrDefault<Switch>("deterministic", false);
+    _firstTouch = smoothDic.lookupOrDefault<Switch>("firstTouch", false);
+    _hugePages = smoothDic.lookupOrDefault<Switch>("hugePages", false);
+    _pinThreads = smoothDic.lookupOrDefault<word>("pinThreads", "none");
+    _placementReport = smoothDic.lookupOrDefault<Switch>
+    (
+        "placementReport",
+        false
+    );
+    _schedule = smoothDic.lookupOrDefault<word>("schedule", "jacobi");
+    _anderson = smoothDic.lookupOrDefault<Switch>("anderson", false);
+    _andersonDepth = smoothDic.lookupOrDefault<label>("andersonDepth", 5);
+    _minCycleEngine = smoothDic.lookupOrDefault<word>
+    (
+        "minCycleEngine",
+        "simultaneous"
+    );
+    _localOptimisation = smoothDic.lookupOrDefault<Switch>
+    (
+        "localOptimisation",
+        false
+    );
+    _localOptimisationSteps = smoothDic.lookupOrDefault<label>
+    (
+        "localOptimisationSteps",
+        5
+    );
+    _lbfgsDepth = smoothDic.lookupOrDefault<label>("lbfgsDepth", 5);
+    _adaptiveTransform = smoothDic.lookupOrDefault<Switch>
+    (
+        "adaptiveTransform",
+        false
+    );
+    _transformParamMin = smoothDic.lookupOrDefault<scalar>
+    (
+        "transformParameterMin",
+        0.1
+    );
+    _transformParamMax = smoothDic.lookupOrDefault<scalar>
+    (
+        "transformParameterMax",
+        1.0
+    );
+    _relaxationMemory = smoothDic.lookupOrDefault<Switch>
+    (
+        "relaxationMemory",
+        false
+    );
 
     if (*_meanRelaxTable.rbegin() > VSMALL)
     {
@@ -68,11 +134,38 @@ Foam::SmootherControl::SmootherControl(dictionary *smootherDict)
         << "  smoothControls:"  << nl
         << "    - Max iterations             : " << _maxIterations  << nl
         << "    - Tranformation parameter    : " << _transformParam << nl
+        << "    - Adaptive transformation    : " << _adaptiveTransform << nl
+        << "    - Transformation range       : " << _transformParamMin
+        << " " << _transformParamMax << nl
         << "    - Mean improvement tolerance : " << _meanImprovTol << nl
         << "    - Max ineffective iteration  : " << _maxMinCycleNoChange << nl
         << "    - Mean relaxation table      : " << _meanRelaxTable << nl
         << "    - Min relaxation table       : " << _minRelaxTable << nl
         << "    - Snap relaxation table      : " << _snapRelaxTable << nl
+        << "    - Relaxation level memory    : " << _relaxationMemory << nl
+        << "    - Multilevel coarse levels   : " << _multiLevels << nl
+        << "    - Iterations per level       : " << _multiLevelIter << nl
+        << "    - Min cycle active set       : " << _activeSet << nl
+        << "    - Out-of-core smoother tables: " << _outOfCore << nl
+        << "    - Renumbering                : " << _renumbering << nl
+        << "    - Point loop threads         : " << _nThreads << nl
+        << "    - Deterministic reductions   : " << _deterministic << nl
+        << "    - Parallel first touch       : " << _firstTouch << nl
+        << "    - Huge pages                 : " << _hugePages << nl
+        << "    - Thread pinning             : " << _pinThreads << nl
+        << "    - GETMe schedule             : " << _schedule << nl
+        << "    - Anderson acceleration      : " << _anderson << nl
+        << "    - Anderson depth             : " << _andersonDepth << nl
+        << "    - Min cycle engine           : " << _minCycleEngine << nl
+        << "    - L-BFGS depth               : " << _lbfgsDepth << nl
+        << "    - Local optimisation         : " << _localOptimisation << nl
+        << "    - Local optimisation steps   : " << _localOptimisationSteps
+        << nl
+#ifdef SMOOTHER_MIXED_PRECISION
+        << "    - Point storage precision    : float" << nl
+#else
+        << "    - Point storage precision    : double" << nl
+#endif
         << nl;
 }
 
@@ -24,6 +24,7 @@ License
 #define MESHSMOOTHERCONTROL_H
 
 #include "scalarList.H"
+#include "fileName.H"
 
 // * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * //
 
@@ -48,6 +49,31 @@ class SmootherControl
         scalar _ratioForMin;
         label _maxMinCycleNoChange;
         label _maxIterations;
+        label _multiLevels;
+        label _multiLevelIter;
+        bool _activeSet;
+        label _activeSetHalo;
+        label _activeSetMaxNoImprove;
+        bool _outOfCore;
+        fileName _scratchDir;
+        word _renumbering;
+        label _nThreads;
+        bool _deterministic;
+        bool _firstTouch;
+        bool _hugePages;
+        word _pinThreads;
+        bool _placementReport;
+        word _schedule;
+        bool _anderson;
+        label _andersonDepth;
+        word _minCycleEngine;
+        bool _localOptimisation;
+        label _localOptimisationSteps;
+        label _lbfgsDepth;
+        bool _adaptiveTransform;
+        scalar _transformParamMin;
+        scalar _transformParamMax;
+        bool _relaxationMemory;
 
 public:
     //- Constructors
@@ -66,6 +92,10 @@ public:
         // Get max of cycles without change during min cycles
         const label& maxMinCycleNoChange() const {return _maxMinCycleNoChange;}
 
+        // Do the GETMe relaxations start from the level of the points at
+        // the previous iteration
+        bool relaxationMemory() const {return _relaxationMemory;}
+
         // Get relaxation table
         const scalarList& minRelaxTable() const {return _minRelaxTable;}
         const scalarList& meanRelaxTable() const {return _meanRelaxTable;}
@@ -74,7 +104,64 @@ public:
         // Get transformation parameter
         const scalar &transformationParameter() const {return _transformParam;}
 
+        // Get adaptive transformation parameter settings
+        bool adaptiveTransform() const {return _adaptiveTransform;}
+        const scalar& transformParameterMin() const {return _transformParamMin;}
+        const scalar& transformParameterMax() const {return _transformParamMax;}
+
         const scalar& ratioForMin() const {return _ratioForMin;}
+
+        // Get number of coarse block levels and iterations per level
+        const label& multiLevels() const {return _multiLevels;}
+        const label& multiLevelIterations() const {return _multiLevelIter;}
+
+        // Get active set settings for min cycles
+        bool activeSet() const {return _activeSet;}
+        const label& activeSetHalo() const {return _activeSetHalo;}
+        const label& activeSetMaxNoImprove() const
+        {
+            return _activeSetMaxNoImprove;
+        }
+
+        // Get out-of-core settings, for the point and cell tables only
+        bool outOfCore() const {return _outOfCore;}
+        const fileName& scratchDir() const {return _scratchDir;}
+
+        // Get placement order of the smoother cells and points
+        const word& renumbering() const {return _renumbering;}
+
+        // Get number of threads of the point loops, 0 for all
+        const label& nThreads() const {return _nThreads;}
+
+        // Are the reductions independent of the number of threads
+        bool deterministic() const {return _deterministic;}
+
+        // Get NUMA placement settings of the smoother tables
+        bool firstTouch() const {return _firstTouch;}
+        bool hugePages() const {return _hugePages;}
+        const word& pinThreads() const {return _pinThreads;}
+        bool placementReport() const {return _placementReport;}
+
+        // Get GETMe schedule, jacobi or multicolour
+        const word& schedule() const {return _schedule;}
+
+        // Get Anderson acceleration settings of the mean cycle
+        bool anderson() const {return _anderson;}
+        const label& andersonDepth() const {return _andersonDepth;}
+
+        // Get min cycle engine, simultaneous, sequential or optimisation
+        const word& minCycleEngine() const {return _minCycleEngine;}
+
+        // Get number of steps kept by the L-BFGS of the optimisation engine
+        const label& lbfgsDepth() const {return _lbfgsDepth;}
+
+        // Get local optimisation settings of the points the min cycle
+        // relaxation put back
+        bool localOptimisation() const {return _localOptimisation;}
+        const label& localOptimisationSteps() const
+        {
+            return _localOptimisationSteps;
+        }
 };
 
 // * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * //
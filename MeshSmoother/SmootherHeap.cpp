@@ -0,0 +1,135 @@
+/*---------------------------------------------------------------------------*\
+  extBlockMesh
+  Copyright (C) 2014 Etudes-NG
+  ---------------------------------
+License
+    This file is part of extBlockMesh.
+
+    extBlockMesh is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    extBlockMesh is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+    FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+    for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with extBlockMesh.  If not, see <http://www.gnu.org/licenses/>.
+
+\*---------------------------------------------------------------------------*/
+
+#include "SmootherHeap.h"
+
+// * * * * * * * * * * * * * * * Private Functions * * * * * * * * * * * * * //
+
+void Foam::SmootherHeap::up(label i)
+{
+    const label item = _heap[i];
+    while (i > 0)
+    {
+        const label parent = (i - 1)/2;
+        if (!before(item, _heap[parent]))
+        {
+            break;
+        }
+        place(i, _heap[parent]);
+        i = parent;
+    }
+    place(i, item);
+}
+
+void Foam::SmootherHeap::down(label i)
+{
+    const label item = _heap[i];
+    while (2*i + 1 < _size)
+    {
+        label child = 2*i + 1;
+        if (child + 1 < _size && before(_heap[child + 1], _heap[child]))
+        {
+            ++child;
+        }
+        if (!before(_heap[child], item))
+        {
+            break;
+        }
+        place(i, _heap[child]);
+        i = child;
+    }
+    place(i, item);
+}
+
+// * * * * * * * * * * * * * * * * Constructors  * * * * * * * * * * * * * * //
+
+Foam::SmootherHeap::SmootherHeap(const label n)
+:
+    _key(n, 0.0),
+    _heap(n, -1),
+    _pos(n, -1),
+    _size(0)
+{
+}
+
+// * * * * * * * * * * * * * * * Member Functions  * * * * * * * * * * * * * //
+
+void Foam::SmootherHeap::set(const label item, const scalar key)
+{
+    if (_pos[item] < 0)
+    {
+        _key[item] = key;
+        place(_size++, item);
+        up(_size - 1);
+    }
+    else if (key < _key[item])
+    {
+        _key[item] = key;
+        up(_pos[item]);
+    }
+    else
+    {
+        _key[item] = key;
+        down(_pos[item]);
+    }
+}
+
+Foam::label Foam::SmootherHeap::pop()
+{
+    const label item = _heap[0];
+    erase(item);
+    return item;
+}
+
+void Foam::SmootherHeap::erase(const label item)
+{
+    const label i = _pos[item];
+    if (i < 0)
+    {
+        return;
+    }
+
+    _pos[item] = -1;
+    if (i == --_size)
+    {
+        return;
+    }
+
+    // Last item moved to the hole, then up or down
+    const label moved = _heap[_size];
+    place(i, moved);
+    up(i);
+    down(_pos[moved]);
+}
+
+void Foam::SmootherHeap::clear()
+{
+    for (label i = 0; i < _size; ++i)
+    {
+        _pos[_heap[i]] = -1;
+    }
+    _size = 0;
+}
+
+// * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * //
+
+// ************************************************************************* //
@@ -0,0 +1,116 @@
+/*---------------------------------------------------------------------------*\
+  extBlockMesh
+  Copyright (C) 2014 Etudes-NG
+  ---------------------------------
+License
+    This file is part of extBlockMesh.
+
+    extBlockMesh is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    extBlockMesh is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+    FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+    for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with extBlockMesh.  If not, see <http://www.gnu.org/licenses/>.
+
+\*---------------------------------------------------------------------------*/
+
+#ifndef SMOOTHERHEAP_H
+#define SMOOTHERHEAP_H
+
+#include "labelList.H"
+#include "scalarList.H"
+
+// * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * //
+
+namespace Foam
+{
+
+/*---------------------------------------------------------------------------*\
+                       Class SmootherHeap Declaration
+\*---------------------------------------------------------------------------*/
+
+// Indexed binary min-heap of the items 0 to n - 1: the key of an item in
+// the heap can be changed and the item removed in O(log n), equal keys
+// are ordered by item so that the pops do not depend on the insertions
+class SmootherHeap
+{
+    //- Private data
+
+        // Key of each item
+        scalarList _key;
+
+        // Items in heap order
+        labelList _heap;
+
+        // Position of each item in the heap, -1 if not in the heap
+        labelList _pos;
+
+        // Number of items in the heap
+        label _size;
+
+    //- Private member functions
+
+        // Is item a before item b
+        bool before(const label a, const label b) const
+        {
+            return _key[a] < _key[b] || (_key[a] == _key[b] && a < b);
+        }
+
+        // Place the item at position i
+        void place(const label i, const label item)
+        {
+            _heap[i] = item;
+            _pos[item] = i;
+        }
+
+        // Move the item at position i up or down to its position
+        void up(label i);
+        void down(label i);
+
+public:
+
+    //- Constructors
+
+        //- Construct empty for the items 0 to n - 1
+        SmootherHeap(const label n);
+
+    //- Member functions
+
+        // Number of items in the heap
+        label size() const {return _size;}
+        bool empty() const {return _size == 0;}
+
+        // Is the item in the heap
+        bool found(const label item) const {return _pos[item] >= 0;}
+
+        // Item of the smallest key
+        label top() const {return _heap[0];}
+
+        // Insert the item or change its key
+        void set(const label item, const scalar key);
+
+        // Remove and return the item of the smallest key
+        label pop();
+
+        // Remove the item if in the heap
+        void erase(const label item);
+
+        // Remove all the items
+        void clear();
+};
+
+// * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * //
+
+} // End namespace Foam
+
+// * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * //
+
+#endif // SMOOTHERHEAP_H
+
+// ************************************************************************* //
@@ -0,0 +1,151 @@
+/*---------------------------------------------------------------------------*\
+  extBlockMesh
+  Copyright (C) 2014 Etudes-NG
+  ---------------------------------
+License
+    This file is part of extBlockMesh.
+
+    extBlockMesh is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    extBlockMesh is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+    FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+    for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with extBlockMesh.  If not, see <http://www.gnu.org/licenses/>.
+
+\*---------------------------------------------------------------------------*/
+
+#include "SmootherInMemory.h"
+
+#include "polyMesh.H"
+#include "polyPatch.H"
+#include "cellModeller.H"
+#include "triSurface.H"
+
+#include "MeshSmoother.h"
+
+// * * * * * * * * * * * * * * * * Constructors  * * * * * * * * * * * * * * //
+
+Foam::SmootherInMemory::SmootherInMemory(const dictionary& smootherDict)
+:
+    _smootherDict(smootherDict),
+    _nbIterations(0)
+{
+    // Nothing is written next to the caller
+    _smootherDict.subDict("snapControls").set("writeFeatures", false);
+
+    dictionary controlDict;
+    controlDict.add("startFrom", word("startTime"));
+    controlDict.add("startTime", scalar(0));
+    controlDict.add("stopAt", word("endTime"));
+    controlDict.add("endTime", scalar(1));
+    controlDict.add("deltaT", scalar(1));
+    controlDict.add("writeControl", word("timeStep"));
+    controlDict.add("writeInterval", scalar(1));
+
+    // The case directory is never created, no object reads or writes
+    _runTime.reset
+    (
+        new Time
+        (
+            controlDict,
+            cwd(),
+            "SmootherInMemory",
+            "system",
+            "constant",
+            false
+        )
+    );
+}
+
+// * * * * * * * * * * * * * * * Member Functions  * * * * * * * * * * * * * //
+
+void Foam::SmootherInMemory::addSurface
+(
+    const word& name,
+    const pointField& points,
+    const labelList& triangles
+)
+{
+    List<labelledTri> tris(triangles.size()/3);
+    forAll(tris, triI)
+    {
+        tris[triI] = labelledTri
+        (
+            triangles[3*triI],
+            triangles[3*triI + 1],
+            triangles[3*triI + 2],
+            0
+        );
+    }
+
+    geometricSurfacePatchList patches(1);
+    patches[0] = geometricSurfacePatch(word("patch"), name, 0);
+
+    _surfCache.insert(name, new triSurface(tris, patches, points));
+}
+
+Foam::scalarField Foam::SmootherInMemory::smooth
+(
+    pointField& points,
+    const labelList& hexes,
+    const wordList& patchNames,
+    const List<faceList>& patchFaces
+)
+{
+    const cellModel& hex = *(cellModeller::lookup("hex"));
+
+    cellShapeList shapes(hexes.size()/8);
+    forAll(shapes, cellI)
+    {
+        shapes[cellI] = cellShape
+        (
+            hex,
+            labelList(SubList<label>(hexes, 8, 8*cellI))
+        );
+    }
+
+    PtrList<dictionary> patchDicts(patchNames.size());
+    forAll(patchDicts, patchI)
+    {
+        patchDicts.set(patchI, new dictionary());
+        patchDicts[patchI].add("type", polyPatch::typeName);
+    }
+
+    polyMesh mesh
+    (
+        IOobject
+        (
+            polyMesh::defaultRegion,
+            _runTime().constant(),
+            _runTime(),
+            IOobject::NO_READ,
+            IOobject::NO_WRITE,
+            false
+        ),
+        xferMove(points),
+        shapes,
+        patchFaces,
+        patchNames,
+        patchDicts,
+        "defaultFaces",
+        polyPatch::typeName
+    );
+
+    MeshSmoother smoother(&mesh, &_smootherDict, 0, &_surfCache);
+    smoother.update();
+    _nbIterations = smoother.nbIterations();
+
+    points = mesh.points();
+
+    return smoother.cellQuality();
+}
+
+// * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * //
+
+// ************************************************************************* //
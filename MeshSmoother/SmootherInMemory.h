@@ -0,0 +1,110 @@
+/*---------------------------------------------------------------------------*\
+  extBlockMesh
+  Copyright (C) 2014 Etudes-NG
+  ---------------------------------
+License
+    This file is part of extBlockMesh.
+
+    extBlockMesh is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    extBlockMesh is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+    FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+    for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with extBlockMesh.  If not, see <http://www.gnu.org/licenses/>.
+
+\*---------------------------------------------------------------------------*/
+
+#ifndef SMOOTHERINMEMORY_H
+#define SMOOTHERINMEMORY_H
+
+#include "Time.H"
+#include "autoPtr.H"
+#include "dictionary.H"
+#include "faceList.H"
+#include "pointField.H"
+
+#include "SmootherSurfaceCache.h"
+
+// * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * //
+
+namespace Foam
+{
+
+/*---------------------------------------------------------------------------*\
+                     Class SmootherInMemory Declaration
+\*---------------------------------------------------------------------------*/
+
+// Smooth meshes given as arrays without case directory: the mesh and the
+// snapping surfaces are built in memory and nothing is read or written
+class SmootherInMemory
+{
+    //- Private data
+
+        // smootherDict controls
+        dictionary _smootherDict;
+
+        // Time of the in-memory meshes
+        autoPtr<Time> _runTime;
+
+        // Snapping surfaces, kept between the smoothings
+        SmootherSurfaceCache _surfCache;
+
+        // Number of iterations of the last smoothing
+        label _nbIterations;
+
+    //- Private member functions
+
+        // Disallow copy
+        SmootherInMemory(const SmootherInMemory&);
+        void operator=(const SmootherInMemory&);
+
+public:
+
+    //- Constructors
+
+        //- Construct from the content of a smootherDict
+        SmootherInMemory(const dictionary& smootherDict);
+
+    //- Member functions
+
+        // Add a snapping surface from its points and triangles (3 labels
+        // per triangle), boundaries of the snapControls use it through
+        // "triSurface name;"
+        void addSurface
+        (
+            const word& name,
+            const pointField& points,
+            const labelList& triangles
+        );
+
+        // Smooth the hexahedra (8 labels per cell in the cellShape order),
+        // the boundary faces are grouped by patch and the faces not given
+        // are put in a defaultFaces patch. The points are moved in place
+        // and the quality of the cells is returned
+        scalarField smooth
+        (
+            pointField& points,
+            const labelList& hexes,
+            const wordList& patchNames,
+            const List<faceList>& patchFaces
+        );
+
+        // Number of iterations of the last smoothing
+        label nbIterations() const {return _nbIterations;}
+};
+
+// * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * //
+
+} // End namespace Foam
+
+// * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * //
+
+#endif // SMOOTHERINMEMORY_H
+
+// ************************************************************************* //
@@ -0,0 +1,382 @@
+/*---------------------------------------------------------------------------*\
+  extBlockMesh
+  Copyright (C) 2014 Etudes-NG
+  ---------------------------------
+License
+    This file is part of extBlockMesh.
+
+    extBlockMesh is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    extBlockMesh is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+    FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+    for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with extBlockMesh.  If not, see <http://www.gnu.org/licenses/>.
+
+\*---------------------------------------------------------------------------*/
+
+#include "SmootherKernel.h"
+
+#include "tensor.H"
+#include "scalarList.H"
+
+#include <stdint.h>
+
+// * * * * * * * * * * * * * * Static Data Members * * * * * * * * * * * * * //
+
+namespace Foam
+{
+    const label SmootherKernel::v1[8] = {3, 0, 1, 2, 7, 4, 5, 6};
+    const label SmootherKernel::v2[8] = {4, 5, 6, 7, 5, 6, 7, 4};
+    const label SmootherKernel::v3[8] = {1, 2, 3, 0, 0, 1, 2, 3};
+    const label SmootherKernel::reductionBlock = 1024;
+}
+
+// * * * * * * * * * * * * * * * Member Functions  * * * * * * * * * * * * * //
+
+const char* Foam::SmootherKernel::powMethodName(const powMethod m)
+{
+    if (m == CBRT)
+    {
+        return "cbrt";
+    }
+    else if (m == FASTPOW)
+    {
+        return "fastPow";
+    }
+    return "std::pow";
+}
+
+Foam::scalar Foam::SmootherKernel::fastPow(const scalar s)
+{
+    // Work on the 32 bits high word whatever the size of label
+    union
+    {
+        double d;
+        int32_t x[2];
+    } u = {s};
+
+    u.x[1] = static_cast<int32_t>(2.0/3.0*(u.x[1] - 1072632447) + 1072632447);
+    u.x[0] = 0;
+    return u.d;
+}
+
+Foam::scalar Foam::SmootherKernel::tetQuality
+(
+    const FixedList<point, 8>& pts,
+    const label ref,
+    const powMethod m
+)
+{
+    const Tensor<scalar> mA
+    (
+        pts[v1[ref]] - pts[ref],
+        pts[v2[ref]] - pts[ref],
+        pts[v3[ref]] - pts[ref]
+    );
+    const scalar sigma(det(mA));
+
+    if (sigma > VSMALL)
+    {
+        return 3.0*pow23(sigma, m)/magSqr(mA);
+    }
+
+    return 0.0;
+}
+
+Foam::scalar Foam::SmootherKernel::hexQuality
+(
+    const FixedList<point, 8>& pts,
+    const powMethod m
+)
+{
+    scalar quality = 0.0;
+    for (label ptI = 0; ptI < 8; ++ptI)
+    {
+        const scalar tetQ(tetQuality(pts, ptI, m));
+
+        if (tetQ < VSMALL)
+        {
+            return 0.0;
+        }
+        quality += tetQ;
+    }
+
+    return quality/8.0;
+}
+
+Foam::scalar Foam::SmootherKernel::hexQualityGradient
+(
+    const FixedList<point, 8>& pts,
+    FixedList<vector, 8>& grad
+)
+{
+    grad = vector::zero;
+
+    scalar quality = 0.0;
+    for (label ref = 0; ref < 8; ++ref)
+    {
+        const vector a = pts[v1[ref]] - pts[ref];
+        const vector b = pts[v2[ref]] - pts[ref];
+        const vector c = pts[v3[ref]] - pts[ref];
+
+        const scalar sigma = a & (b ^ c);
+        if (sigma < VSMALL)
+        {
+            grad = vector::zero;
+            return 0.0;
+        }
+        const scalar norm = magSqr(a) + magSqr(b) + magSqr(c);
+        const scalar q = 3.0*std::pow(sigma, 2.0/3.0)/norm;
+
+        // q = 3 sigma^(2/3)/norm, d(sigma)/da = b^c and d(norm)/da = 2a
+        const vector ga = q*((2.0/3.0)*(b ^ c)/sigma - 2.0*a/norm);
+        const vector gb = q*((2.0/3.0)*(c ^ a)/sigma - 2.0*b/norm);
+        const vector gc = q*((2.0/3.0)*(a ^ b)/sigma - 2.0*c/norm);
+
+        grad[v1[ref]] += ga;
+        grad[v2[ref]] += gb;
+        grad[v3[ref]] += gc;
+        grad[ref] -= ga + gb + gc;
+
+        quality += q;
+    }
+
+    forAll(grad, ptI)
+    {
+        grad[ptI] /= 8.0;
+    }
+
+    return quality/8.0;
+}
+
+void Foam::SmootherKernel::hexQualityBatch
+(
+    const label n,
+    const scalar* x,
+    const scalar* y,
+    const scalar* z,
+    scalar* q,
+    const powMethod m
+)
+{
+    for (label cellI = 0; cellI < n; ++cellI)
+    {
+        scalar quality = 0.0;
+        scalar valid = 1.0;
+
+        for (label ref = 0; ref < 8; ++ref)
+        {
+            const label o = ref*n + cellI;
+            const label a = v1[ref]*n + cellI;
+            const label b = v2[ref]*n + cellI;
+            const label c = v3[ref]*n + cellI;
+
+            const scalar ax = x[a] - x[o], ay = y[a] - y[o], az = z[a] - z[o];
+            const scalar bx = x[b] - x[o], by = y[b] - y[o], bz = z[b] - z[o];
+            const scalar cx = x[c] - x[o], cy = y[c] - y[o], cz = z[c] - z[o];
+
+            const scalar sigma =
+                ax*(by*cz - bz*cy) - ay*(bx*cz - bz*cx) + az*(bx*cy - by*cx);
+            const scalar norm =
+                ax*ax + ay*ay + az*az
+              + bx*bx + by*by + bz*bz
+              + cx*cx + cy*cy + cz*cz;
+
+            // Branch free: an invalid corner nullifies the whole cell, a
+            // collapsed one must not divide by zero
+            const scalar s = (sigma > VSMALL) ? sigma : 1.0;
+            valid *= (sigma > VSMALL) ? 1.0 : 0.0;
+            quality += 3.0*pow23(s, m)/max(norm, VSMALL);
+        }
+
+        q[cellI] = valid*quality/8.0;
+    }
+}
+
+Foam::scalar Foam::SmootherKernel::pairwiseSum
+(
+    const scalar* v,
+    const label n
+)
+{
+    if (n <= 2)
+    {
+        return n == 2 ? v[0] + v[1] : (n == 1 ? v[0] : 0.0);
+    }
+
+    const label half = n/2;
+    return pairwiseSum(v, half) + pairwiseSum(v + half, n - half);
+}
+
+Foam::scalar Foam::SmootherKernel::deterministicSum
+(
+    const scalar* v,
+    const label n,
+    const label nThreads
+)
+{
+    const label nBlocks = (n + reductionBlock - 1)/reductionBlock;
+    scalarList blockSum(nBlocks, 0.0);
+
+    #pragma omp parallel for schedule(static) num_threads(nThreads)
+    for (label b = 0; b < nBlocks; ++b)
+    {
+        const label end = min((b + 1)*reductionBlock, n);
+        scalar s = 0.0;
+        for (label i = b*reductionBlock; i < end; ++i)
+        {
+            s += v[i];
+        }
+        blockSum[b] = s;
+    }
+
+    return pairwiseSum(blockSum.cdata(), nBlocks);
+}
+
+void Foam::SmootherKernel::transform
+(
+    const FixedList<point, 8>& pts,
+    const scalar t,
+    FixedList<point, 8>& H
+)
+{
+    // Faces centres
+    FixedList<point, 6> fc;
+    const label f[] = {0, 0, 1, 2, 0, 4};
+    const label g[] = {1, 4, 5, 6, 3, 7};
+    const label h[] = {2, 5, 6, 7, 7, 6};
+    const label i[] = {3, 1, 2, 3, 4, 5};
+    for (label j = 0; j < 6; ++j)
+    {
+        fc[j] = (pts[f[j]] + pts[g[j]] + pts[h[j]] + pts[i[j]])/4.0;
+    }
+
+    // Transformed points
+    const label a[] = {0, 0, 0, 0, 5, 5, 5, 5};
+    const label b[] = {1, 2, 3, 4, 4, 1, 2, 3};
+    const label d[] = {4, 1, 2, 3, 1, 2, 3, 4};
+    for (label j = 0; j < 8; ++j)
+    {
+        const point c = (fc[a[j]] + fc[b[j]] + fc[d[j]])/3.0;
+        const point n = (fc[b[j]] - fc[a[j]]) ^ (fc[d[j]] - fc[a[j]]);
+        H[j] = c + t/std::sqrt(mag(n))*n;
+    }
+
+    // Length scale
+    scalar length = 0.0, lengthN = 0.0;
+    const label k[] = {0, 1, 2, 3, 0, 1, 2, 3, 4, 5, 6, 7};
+    const label l[] = {1, 2, 3, 0, 4, 5, 6, 7, 5, 6, 7, 4};
+    for (label j = 0; j < 12; ++j)
+    {
+        length += mag(pts[k[j]] - pts[l[j]]);
+        lengthN += mag(H[k[j]] - H[l[j]]);
+    }
+    length /= lengthN;
+
+    const point c = (H[0] + H[1] + H[2] + H[3] + H[4] + H[5] + H[6] + H[7])/8.0;
+
+    for (label j = 0; j < 8; ++j)
+    {
+        H[j] = c + length*(H[j] - c);
+    }
+}
+
+void Foam::SmootherKernel::transformBatch
+(
+    const label n,
+    const scalar* x,
+    const scalar* y,
+    const scalar* z,
+    const scalar t,
+    scalar* hx,
+    scalar* hy,
+    scalar* hz
+)
+{
+    const label f[] = {0, 0, 1, 2, 0, 4};
+    const label g[] = {1, 4, 5, 6, 3, 7};
+    const label h[] = {2, 5, 6, 7, 7, 6};
+    const label i[] = {3, 1, 2, 3, 4, 5};
+    const label a[] = {0, 0, 0, 0, 5, 5, 5, 5};
+    const label b[] = {1, 2, 3, 4, 4, 1, 2, 3};
+    const label d[] = {4, 1, 2, 3, 1, 2, 3, 4};
+    const label k[] = {0, 1, 2, 3, 0, 1, 2, 3, 4, 5, 6, 7};
+    const label l[] = {1, 2, 3, 0, 4, 5, 6, 7, 5, 6, 7, 4};
+
+    for (label cellI = 0; cellI < n; ++cellI)
+    {
+        scalar fx[6], fy[6], fz[6];
+        for (label j = 0; j < 6; ++j)
+        {
+            const label pf = f[j]*n + cellI, pg = g[j]*n + cellI;
+            const label ph = h[j]*n + cellI, pi = i[j]*n + cellI;
+            fx[j] = (x[pf] + x[pg] + x[ph] + x[pi])/4.0;
+            fy[j] = (y[pf] + y[pg] + y[ph] + y[pi])/4.0;
+            fz[j] = (z[pf] + z[pg] + z[ph] + z[pi])/4.0;
+        }
+
+        scalar Hx[8], Hy[8], Hz[8];
+        for (label j = 0; j < 8; ++j)
+        {
+            const scalar ux = fx[b[j]] - fx[a[j]];
+            const scalar uy = fy[b[j]] - fy[a[j]];
+            const scalar uz = fz[b[j]] - fz[a[j]];
+            const scalar vx = fx[d[j]] - fx[a[j]];
+            const scalar vy = fy[d[j]] - fy[a[j]];
+            const scalar vz = fz[d[j]] - fz[a[j]];
+
+            const scalar nx = uy*vz - uz*vy;
+            const scalar ny = uz*vx - ux*vz;
+            const scalar nz = ux*vy - uy*vx;
+            const scalar s = t/std::sqrt(std::sqrt(nx*nx + ny*ny + nz*nz));
+
+            Hx[j] = (fx[a[j]] + fx[b[j]] + fx[d[j]])/3.0 + s*nx;
+            Hy[j] = (fy[a[j]] + fy[b[j]] + fy[d[j]])/3.0 + s*ny;
+            Hz[j] = (fz[a[j]] + fz[b[j]] + fz[d[j]])/3.0 + s*nz;
+        }
+
+        scalar length = 0.0, lengthN = 0.0;
+        for (label j = 0; j < 12; ++j)
+        {
+            const label pk = k[j]*n + cellI, pl = l[j]*n + cellI;
+            const scalar ex = x[pk] - x[pl];
+            const scalar ey = y[pk] - y[pl];
+            const scalar ez = z[pk] - z[pl];
+            length += std::sqrt(ex*ex + ey*ey + ez*ez);
+
+            const scalar Ex = Hx[k[j]] - Hx[l[j]];
+            const scalar Ey = Hy[k[j]] - Hy[l[j]];
+            const scalar Ez = Hz[k[j]] - Hz[l[j]];
+            lengthN += std::sqrt(Ex*Ex + Ey*Ey + Ez*Ez);
+        }
+        length /= lengthN;
+
+        scalar cx = 0.0, cy = 0.0, cz = 0.0;
+        for (label j = 0; j < 8; ++j)
+        {
+            cx += Hx[j];
+            cy += Hy[j];
+            cz += Hz[j];
+        }
+        cx /= 8.0;
+        cy /= 8.0;
+        cz /= 8.0;
+
+        for (label j = 0; j < 8; ++j)
+        {
+            hx[j*n + cellI] = cx + length*(Hx[j] - cx);
+            hy[j*n + cellI] = cy + length*(Hy[j] - cy);
+            hz[j*n + cellI] = cz + length*(Hz[j] - cz);
+        }
+    }
+}
+
+// * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * //
+
+// ************************************************************************* //
@@ -0,0 +1,167 @@
+/*---------------------------------------------------------------------------*\
+  extBlockMesh
+  Copyright (C) 2014 Etudes-NG
+  ---------------------------------
+License
+    This file is part of extBlockMesh.
+
+    extBlockMesh is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    extBlockMesh is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+    FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+    for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with extBlockMesh.  If not, see <http://www.gnu.org/licenses/>.
+
+\*---------------------------------------------------------------------------*/
+
+#ifndef SMOOTHERKERNEL_H
+#define SMOOTHERKERNEL_H
+
+#include "FixedList.H"
+#include "point.H"
+
+#include <cmath>
+
+// * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * //
+
+namespace Foam
+{
+
+/*---------------------------------------------------------------------------*\
+                       Class SmootherKernel Declaration
+\*---------------------------------------------------------------------------*/
+
+class SmootherKernel
+{
+public:
+
+    //- Public data
+
+        // Method used to compute sigma^(2/3) in the mean ratio
+        enum powMethod
+        {
+            STDPOW,
+            CBRT,
+            FASTPOW
+        };
+
+        // Corner tetrahedra of the hexahedron (v0 is the corner itself)
+        static const label v1[8];
+        static const label v2[8];
+        static const label v3[8];
+
+        // Number of values summed serially by deterministicSum
+        static const label reductionBlock;
+
+    //- Static member functions
+
+        // Name of the pow method
+        static const char* powMethodName(const powMethod m);
+
+        // Compute sigma^(2/3) with the given method
+        static inline scalar pow23(const scalar s, const powMethod m);
+
+        // Approximated sigma^(2/3), see
+        // http://martin.ankerl.com/2012/01/25/optimized-approximative-pow-in-c-and-cpp/
+        static scalar fastPow(const scalar s);
+
+        // Mean ratio of a corner tetrahedron of the hexahedron
+        static scalar tetQuality
+        (
+            const FixedList<point, 8>& pts,
+            const label ref,
+            const powMethod m = STDPOW
+        );
+
+        // Mean ratio of the hexahedron, null if a corner tet is invalid
+        static scalar hexQuality
+        (
+            const FixedList<point, 8>& pts,
+            const powMethod m = STDPOW
+        );
+
+        // Mean ratio of the hexahedron and its gradient with respect to
+        // the points, null if a corner tet is invalid
+        static scalar hexQualityGradient
+        (
+            const FixedList<point, 8>& pts,
+            FixedList<vector, 8>& grad
+        );
+
+        // Mean ratio of n hexahedra stored point-major as structure of
+        // arrays (x[p*n + cellI]), written so that the loop over the cells
+        // can be vectorised
+        static void hexQualityBatch
+        (
+            const label n,
+            const scalar* x,
+            const scalar* y,
+            const scalar* z,
+            scalar* q,
+            const powMethod m = STDPOW
+        );
+
+        // GETMe dual element transformation of the hexahedron
+        static void transform
+        (
+            const FixedList<point, 8>& pts,
+            const scalar t,
+            FixedList<point, 8>& H
+        );
+
+        // Sum of v[0] to v[n - 1] added in a binary tree
+        static scalar pairwiseSum(const scalar* v, const label n);
+
+        // Sum of v[0] to v[n - 1] by blocks of reductionBlock values, the
+        // block sums added by pairwiseSum: the same bits whatever nThreads
+        static scalar deterministicSum
+        (
+            const scalar* v,
+            const label n,
+            const label nThreads
+        );
+
+        // GETMe transformation of n hexahedra stored as structure of arrays
+        static void transformBatch
+        (
+            const label n,
+            const scalar* x,
+            const scalar* y,
+            const scalar* z,
+            const scalar t,
+            scalar* hx,
+            scalar* hy,
+            scalar* hz
+        );
+};
+
+scalar SmootherKernel::pow23(const scalar s, const powMethod m)
+{
+    if (m == CBRT)
+    {
+        const scalar c = Foam::cbrt(s);
+        return c*c;
+    }
+    else if (m == FASTPOW)
+    {
+        return fastPow(s);
+    }
+
+    return std::pow(s, 2.0/3.0);
+}
+
+// * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * //
+
+} // End namespace Foam
+
+// * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * //
+
+#endif // SMOOTHERKERNEL_H
+
+// ************************************************************************* //
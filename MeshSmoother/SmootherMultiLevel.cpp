@@ -0,0 +1,558 @@
+/*---------------------------------------------------------------------------*\
+  extBlockMesh
+  Copyright (C) 2014 Etudes-NG
+  ---------------------------------
+License
+    This file is part of extBlockMesh.
+
+    extBlockMesh is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    extBlockMesh is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+    FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+    for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with extBlockMesh.  If not, see <http://www.gnu.org/licenses/>.
+
+\*---------------------------------------------------------------------------*/
+
+#include "SmootherMultiLevel.h"
+
+#include "blockMesh.H"
+#include "HashSet.H"
+#include "boolList.H"
+#include "DynamicList.H"
+
+#include "SmootherBoundary.h"
+#include "SmootherControl.h"
+#include "SmootherKernel.h"
+#include "SmootherPoint.h"
+
+// * * * * * * * * * * * * * * * Local Functions * * * * * * * * * * * * * * //
+
+namespace Foam
+{
+    // Quality of the hexahedron h of the points x
+    template<class Hex>
+    static scalar latticeHexQuality(const pointField& x, const Hex& h)
+    {
+        FixedList<point, 8> pts;
+        forAll(pts, ptI)
+        {
+            pts[ptI] = x[h[ptI]];
+        }
+        return SmootherKernel::hexQuality(pts);
+    }
+
+    // Corners of a lattice hexahedron in the blockMesh hex order
+    static const label hexDi[8] = {0, 1, 1, 0, 0, 1, 1, 0};
+    static const label hexDj[8] = {0, 0, 1, 1, 0, 0, 1, 1};
+    static const label hexDk[8] = {0, 0, 0, 0, 1, 1, 1, 1};
+}
+
+// * * * * * * * * * * * * * * * Private Functions * * * * * * * * * * * * * //
+
+void Foam::SmootherMultiLevel::buildLattice()
+{
+    const cellShapeList& cells = _blocks->cells();
+
+    _density.setSize(_blocks->size());
+    _lattice.setSize(_blocks->size());
+
+    // Running cell counter, cells are numbered block after block
+    label cellI = 0;
+
+    forAll(*_blocks, blockI)
+    {
+        const block& b = (*_blocks)[blockI];
+        const label nCells = b.cells().size();
+
+        FixedList<label, 3>& n = _density[blockI];
+        n[0] = b.blockDef().meshDensity().x();
+        n[1] = b.blockDef().meshDensity().y();
+        n[2] = b.blockDef().meshDensity().z();
+
+        labelList& lat = _lattice[blockI];
+        lat.setSize((n[0] + 1)*(n[1] + 1)*(n[2] + 1), -1);
+
+        bool isHex = (nCells == n[0]*n[1]*n[2]);
+        for (label k = 0; k < n[2] && isHex; ++k)
+        {
+            for (label j = 0; j < n[1] && isHex; ++j)
+            {
+                for (label i = 0; i < n[0] && isHex; ++i)
+                {
+                    const cellShape& cS = cells[cellI + i + n[0]*(j + n[1]*k)];
+
+                    // Collapsed hex with repeated corners, the block is not a
+                    // lattice
+                    for (label p = 1; p < 8 && isHex; ++p)
+                    {
+                        for (label q = 0; q < p && isHex; ++q)
+                        {
+                            isHex = (cS[p] != cS[q]);
+                        }
+                    }
+
+                    for (label p = 0; p < 8 && isHex; ++p)
+                    {
+                        lat
+                        [
+                            (i + hexDi[p])
+                          + (j + hexDj[p])*(n[0] + 1)
+                          + (k + hexDk[p])*(n[0] + 1)*(n[1] + 1)
+                        ] = cS[p];
+                    }
+                }
+            }
+        }
+
+        if (!isHex)
+        {
+            lat.clear();
+        }
+
+        cellI += nCells;
+    }
+}
+
+Foam::labelList Foam::SmootherMultiLevel::coarseIndices
+(
+    const label n,
+    const label stride
+)
+{
+    DynamicList<label> ind(n/stride + 2);
+    for (label i = 0; i < n; i += stride)
+    {
+        ind.append(i);
+    }
+    ind.append(n);
+
+    return labelList(ind.xfer());
+}
+
+void Foam::SmootherMultiLevel::smoothLevel
+(
+    const label stride,
+    pointField& disp
+)
+{
+    // Coarse nodes and hexahedra
+    labelList node(_nPoints, -1);
+    DynamicList<label> nodePt;
+    DynamicList<FixedList<label, 8> > hexes;
+
+    forAll(_lattice, blockI)
+    {
+        if (_lattice[blockI].empty())
+        {
+            continue;
+        }
+
+        const FixedList<label, 3>& n = _density[blockI];
+        const labelList& lat = _lattice[blockI];
+        const labelList ci = coarseIndices(n[0], stride);
+        const labelList cj = coarseIndices(n[1], stride);
+        const labelList ck = coarseIndices(n[2], stride);
+
+        for (label K = 0; K < ck.size() - 1; ++K)
+        {
+            for (label J = 0; J < cj.size() - 1; ++J)
+            {
+                for (label I = 0; I < ci.size() - 1; ++I)
+                {
+                    FixedList<label, 8> h;
+                    for (label p = 0; p < 8; ++p)
+                    {
+                        const label ptI = lat
+                        [
+                            ci[I + hexDi[p]]
+                          + cj[J + hexDj[p]]*(n[0] + 1)
+                          + ck[K + hexDk[p]]*(n[0] + 1)*(n[1] + 1)
+                        ];
+
+                        if (node[ptI] == -1)
+                        {
+                            node[ptI] = nodePt.size();
+                            nodePt.append(ptI);
+                        }
+                        h[p] = node[ptI];
+                    }
+                    hexes.append(h);
+                }
+            }
+        }
+    }
+
+    const label nNodes = nodePt.size();
+
+    // Coarse points, boundary points are fixed
+    pointField x0(nNodes);
+    boolList fixed(nNodes);
+    forAll(nodePt, nodeI)
+    {
+        const SmootherPoint* pt = _bnd->pt(nodePt[nodeI]);
+        x0[nodeI] = pt->getRelaxedPoint();
+        fixed[nodeI] = pt->isSurface();
+    }
+
+    // Node to cells addressing, nodes of invalid coarse cells are fixed
+    labelList nNei(nNodes, 0);
+    forAll(hexes, cellI)
+    {
+        const bool valid = latticeHexQuality(x0, hexes[cellI]) > VSMALL;
+        forAll(hexes[cellI], p)
+        {
+            ++nNei[hexes[cellI][p]];
+            fixed[hexes[cellI][p]] = fixed[hexes[cellI][p]] || !valid;
+        }
+    }
+    labelListList nodeCells(nNodes);
+    forAll(nodeCells, nodeI)
+    {
+        nodeCells[nodeI].setSize(nNei[nodeI]);
+        nNei[nodeI] = 0;
+    }
+    forAll(hexes, cellI)
+    {
+        forAll(hexes[cellI], p)
+        {
+            const label nodeI = hexes[cellI][p];
+            nodeCells[nodeI][nNei[nodeI]++] = cellI;
+        }
+    }
+
+    // GETMe iterations on the coarse lattice
+    const scalarList& r = _ctrl->meanRelaxTable();
+    const scalar t = _ctrl->transformationParameter();
+
+    pointField x(x0);
+    scalarField q(hexes.size());
+    scalar minQ0 = 1.0, meanQ0 = 0.0;
+
+    for (label iter = 0; iter < _ctrl->multiLevelIterations(); ++iter)
+    {
+        forAll(hexes, cellI)
+        {
+            q[cellI] = latticeHexQuality(x, hexes[cellI]);
+        }
+        if (iter == 0)
+        {
+            minQ0 = min(q);
+            meanQ0 = average(q);
+        }
+
+        scalarField avgQ(nNodes, 0.0);
+        forAll(nodeCells, nodeI)
+        {
+            forAll(nodeCells[nodeI], cI)
+            {
+                avgQ[nodeI] += q[nodeCells[nodeI][cI]];
+            }
+            avgQ[nodeI] /= nodeCells[nodeI].size();
+        }
+
+        // Weighted sum of the transformed cells
+        pointField target(nNodes, vector::zero);
+        scalarField wSum(nNodes, 0.0);
+        forAll(hexes, cellI)
+        {
+            if (q[cellI] < VSMALL)
+            {
+                continue;
+            }
+
+            FixedList<point, 8> pts;
+            forAll(pts, p)
+            {
+                pts[p] = x[hexes[cellI][p]];
+            }
+            FixedList<point, 8> H;
+            SmootherKernel::transform(pts, t, H);
+
+            forAll(H, p)
+            {
+                const label nodeI = hexes[cellI][p];
+                const scalar w = std::sqrt
+                (
+                    avgQ[nodeI]/(nodeCells[nodeI].size()*q[cellI])
+                );
+                wSum[nodeI] += w;
+                target[nodeI] += w*H[p];
+            }
+        }
+
+        // Relax moved nodes until all coarse cells are valid
+        const pointField xOld(x);
+        labelList level(nNodes, 0);
+        labelHashSet moving;
+        forAll(target, nodeI)
+        {
+            if (!fixed[nodeI] && wSum[nodeI] > VSMALL)
+            {
+                target[nodeI] /= wSum[nodeI];
+                moving.insert(nodeI);
+            }
+        }
+
+        while (!moving.empty())
+        {
+            labelHashSet modifiedCells;
+            forAllConstIter(labelHashSet, moving, iterI)
+            {
+                const label nodeI = iterI.key();
+                const scalar rI = r[level[nodeI]];
+                x[nodeI] = (1.0 - rI)*xOld[nodeI] + rI*target[nodeI];
+                modifiedCells.insert(nodeCells[nodeI]);
+            }
+
+            moving.clearStorage();
+            forAllConstIter(labelHashSet, modifiedCells, iterC)
+            {
+                const FixedList<label, 8>& h = hexes[iterC.key()];
+                if (latticeHexQuality(x, h) < VSMALL)
+                {
+                    forAll(h, p)
+                    {
+                        if (!fixed[h[p]] && level[h[p]] + 1 < r.size())
+                        {
+                            ++level[h[p]];
+                            moving.insert(h[p]);
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    forAll(hexes, cellI)
+    {
+        q[cellI] = latticeHexQuality(x, hexes[cellI]);
+    }
+
+    Info<< "    - Stride " << stride << ", " << hexes.size() << " cells"
+        << ", min quality " << minQ0 << " -> " << min(q)
+        << ", mean quality " << meanQ0 << " -> " << average(q) << nl;
+
+    prolongate(stride, node, x - x0, disp);
+}
+
+void Foam::SmootherMultiLevel::prolongate
+(
+    const label stride,
+    const labelList& node,
+    const pointField& coarseDisp,
+    pointField& disp
+) const
+{
+    pointField sum(_nPoints, vector::zero);
+    labelList count(_nPoints, 0);
+
+    forAll(_lattice, blockI)
+    {
+        if (_lattice[blockI].empty())
+        {
+            continue;
+        }
+
+        const FixedList<label, 3>& n = _density[blockI];
+        const labelList& lat = _lattice[blockI];
+        FixedList<labelList, 3> c;
+        FixedList<labelList, 3> interval;
+        for (label dir = 0; dir < 3; ++dir)
+        {
+            c[dir] = coarseIndices(n[dir], stride);
+            interval[dir].setSize(n[dir] + 1);
+            for (label i = 0; i <= n[dir]; ++i)
+            {
+                interval[dir][i] = min(i/stride, c[dir].size() - 2);
+            }
+        }
+
+        for (label k = 0; k <= n[2]; ++k)
+        {
+            for (label j = 0; j <= n[1]; ++j)
+            {
+                for (label i = 0; i <= n[0]; ++i)
+                {
+                    const label ptI =
+                        lat[i + j*(n[0] + 1) + k*(n[0] + 1)*(n[1] + 1)];
+
+                    if (node[ptI] != -1 || _bnd->pt(ptI)->isSurface())
+                    {
+                        continue;
+                    }
+
+                    const label I = interval[0][i];
+                    const label J = interval[1][j];
+                    const label K = interval[2][k];
+
+                    const scalar u[3] =
+                    {
+                        scalar(i - c[0][I])/(c[0][I + 1] - c[0][I]),
+                        scalar(j - c[1][J])/(c[1][J + 1] - c[1][J]),
+                        scalar(k - c[2][K])/(c[2][K + 1] - c[2][K])
+                    };
+
+                    // Trilinear interpolation from the coarse corners
+                    vector d = vector::zero;
+                    for (label p = 0; p < 8; ++p)
+                    {
+                        const label cPtI = lat
+                        [
+                            c[0][I + hexDi[p]]
+                          + c[1][J + hexDj[p]]*(n[0] + 1)
+                          + c[2][K + hexDk[p]]*(n[0] + 1)*(n[1] + 1)
+                        ];
+
+                        const scalar w =
+                            (hexDi[p] ? u[0] : 1.0 - u[0])
+                           *(hexDj[p] ? u[1] : 1.0 - u[1])
+                           *(hexDk[p] ? u[2] : 1.0 - u[2]);
+
+                        d += w*coarseDisp[node[cPtI]];
+                    }
+
+                    // Points of block interfaces are averaged
+                    sum[ptI] += d;
+                    ++count[ptI];
+                }
+            }
+        }
+    }
+
+    forAll(disp, ptI)
+    {
+        if (node[ptI] != -1)
+        {
+            disp[ptI] = coarseDisp[node[ptI]];
+        }
+        else if (count[ptI] > 0)
+        {
+            disp[ptI] = sum[ptI]/count[ptI];
+        }
+    }
+}
+
+void Foam::SmootherMultiLevel::applyDisplacement(const pointField& disp)
+{
+    pointField x0(_nPoints);
+    forAll(x0, ptI)
+    {
+        x0[ptI] = _bnd->pt(ptI)->getRelaxedPoint();
+    }
+    pointField x(x0 + disp);
+
+    // Inverted fine cells, the mesh cells are the blockMesh cells
+    const cellShapeList& cells = _blocks->cells();
+    const labelListList& pointCells = _bnd->mesh().pointCells();
+    const label nCells = cells.size();
+
+    boolList inverted(nCells);
+    #pragma omp parallel for schedule(static) num_threads(_nThreads)
+    for (label cellI = 0; cellI < nCells; ++cellI)
+    {
+        inverted[cellI] = latticeHexQuality(x, cells[cellI]) < VSMALL;
+    }
+
+    DynamicList<label> badCells;
+    forAll(inverted, cellI)
+    {
+        if (inverted[cellI])
+        {
+            badCells.append(cellI);
+        }
+    }
+
+    // Revert their points until the mesh is valid, only the cells of the
+    // points reverted by a pass can be inverted by it
+    label nReverted = 0;
+    while (!badCells.empty())
+    {
+        labelHashSet nextCells;
+        forAll(badCells, i)
+        {
+            const cellShape& cS = cells[badCells[i]];
+            if (latticeHexQuality(x, cS) >= VSMALL)
+            { // Fixed by the points reverted for another cell
+
+                continue;
+            }
+
+            forAll(cS, p)
+            {
+                if (x[cS[p]] != x0[cS[p]])
+                {
+                    x[cS[p]] = x0[cS[p]];
+                    ++nReverted;
+                    nextCells.insert(pointCells[cS[p]]);
+                }
+            }
+        }
+
+        badCells.clear();
+        forAllConstIter(labelHashSet, nextCells, iter)
+        {
+            if (latticeHexQuality(x, cells[iter.key()]) < VSMALL)
+            {
+                badCells.append(iter.key());
+            }
+        }
+    }
+
+    if (nReverted > 0)
+    {
+        Info<< "      " << nReverted << " points reverted to keep valid cells"
+            << nl;
+    }
+
+    forAll(x, ptI)
+    {
+        _bnd->pt(ptI)->resetPoint(x[ptI]);
+    }
+}
+
+// * * * * * * * * * * * * * * * * Constructors  * * * * * * * * * * * * * * //
+
+Foam::SmootherMultiLevel::SmootherMultiLevel
+(
+    const blockMesh* blocks,
+    SmootherBoundary* bnd,
+    const SmootherControl* ctrl,
+    const label nPoints,
+    const label nThreads
+)
+:
+    _blocks(blocks),
+    _bnd(bnd),
+    _ctrl(ctrl),
+    _nPoints(nPoints),
+    _nThreads(nThreads)
+{
+    buildLattice();
+}
+
+// * * * * * * * * * * * * * * * Member Functions  * * * * * * * * * * * * * //
+
+void Foam::SmootherMultiLevel::smooth()
+{
+    Info<< "Multilevel smoothing of the block lattices" << nl;
+
+    for (label level = _ctrl->multiLevels(); level > 0; --level)
+    {
+        pointField disp(_nPoints, vector::zero);
+        smoothLevel(1 << level, disp);
+        applyDisplacement(disp);
+    }
+
+    Info<< nl;
+}
+
+// * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * //
+
+// ************************************************************************* //
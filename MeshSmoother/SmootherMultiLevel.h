@@ -0,0 +1,116 @@
+/*---------------------------------------------------------------------------*\
+  extBlockMesh
+  Copyright (C) 2014 Etudes-NG
+  ---------------------------------
+License
+    This file is part of extBlockMesh.
+
+    extBlockMesh is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    extBlockMesh is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+    FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+    for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with extBlockMesh.  If not, see <http://www.gnu.org/licenses/>.
+
+\*---------------------------------------------------------------------------*/
+
+#ifndef SMOOTHERMULTILEVEL_H
+#define SMOOTHERMULTILEVEL_H
+
+#include "labelList.H"
+#include "pointField.H"
+#include "FixedList.H"
+
+// * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * //
+
+namespace Foam
+{
+class blockMesh;
+class SmootherBoundary;
+class SmootherControl;
+
+/*---------------------------------------------------------------------------*\
+                    Class SmootherMultiLevel Declaration
+\*---------------------------------------------------------------------------*/
+
+class SmootherMultiLevel
+{
+    //- Private data
+
+        // Pointer of parents
+        const blockMesh* _blocks;
+        SmootherBoundary* _bnd;
+        const SmootherControl* _ctrl;
+
+        // Number of points of the mesh
+        label _nPoints;
+
+        // Number of threads of the full mesh loops
+        label _nThreads;
+
+        // Number of cells of each block in i, j and k
+        List<FixedList<label, 3> > _density;
+
+        // Lattice of each block as mesh point labels, node (i, j, k) is
+        // stored at i + j*(ni + 1) + k*(ni + 1)*(nj + 1)
+        labelListList _lattice;
+
+    //- Private member functions
+
+        // Build the lattice of the blocks from the blockMesh cells
+        void buildLattice();
+
+        // Lattice indices kept at a given stride along one direction
+        static labelList coarseIndices(const label n, const label stride);
+
+        // Smooth the lattice subsampled at stride and return the
+        // displacement of the mesh points
+        void smoothLevel(const label stride, pointField& disp);
+
+        // Interpolate the coarse displacement on the fine lattice
+        void prolongate
+        (
+            const label stride,
+            const labelList& node,
+            const pointField& coarseDisp,
+            pointField& disp
+        ) const;
+
+        // Move the points, reverting the points of inverted cells
+        void applyDisplacement(const pointField& disp);
+
+public:
+
+    //- Constructors
+
+        //- Construct from blockMesh and smoother boundary
+        SmootherMultiLevel
+        (
+            const blockMesh* blocks,
+            SmootherBoundary* bnd,
+            const SmootherControl* ctrl,
+            const label nPoints,
+            const label nThreads
+        );
+
+    //- Member functions
+
+        // Smooth from the coarsest level down to the finest coarse level
+        void smooth();
+};
+
+// * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * //
+
+} // End namespace Foam
+
+// * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * //
+
+#endif // SMOOTHERMULTILEVEL_H
+
+// ************************************************************************* //
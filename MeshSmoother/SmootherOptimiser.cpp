@@ -0,0 +1,350 @@
+/*---------------------------------------------------------------------------*\
+  extBlockMesh
+  Copyright (C) 2014 Etudes-NG
+  ---------------------------------
+License
+    This file is part of extBlockMesh.
+
+    extBlockMesh is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    extBlockMesh is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+    FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+    for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with extBlockMesh.  If not, see <http://www.gnu.org/licenses/>.
+
+\*---------------------------------------------------------------------------*/
+
+#include "SmootherOptimiser.h"
+
+#include "polyMesh.H"
+
+#include "SmootherBoundary.h"
+#include "SmootherCell.h"
+#include "SmootherControl.h"
+#include "SmootherKernel.h"
+#include "SmootherPoint.h"
+
+// * * * * * * * * * * * * * * * Private Functions * * * * * * * * * * * * * //
+
+Foam::scalar Foam::SmootherOptimiser::sum(const scalarField& v) const
+{
+    if (_deterministic)
+    {
+        return SmootherKernel::deterministicSum(v.cdata(), v.size(), _nThreads);
+    }
+
+    const label n = v.size();
+    scalar s = 0.0;
+
+    #pragma omp parallel for schedule(static) num_threads(_nThreads) \
+        reduction(+:s)
+    for (label i = 0; i < n; ++i)
+    {
+        s += v[i];
+    }
+    return s;
+}
+
+Foam::scalar Foam::SmootherOptimiser::dot
+(
+    const vectorField& a,
+    const vectorField& b
+)
+{
+    const label n = _pts.size();
+
+    #pragma omp parallel for schedule(static) num_threads(_nThreads)
+    for (label i = 0; i < n; ++i)
+    {
+        _pointValue[i] = a[i] & b[i];
+    }
+    return sum(_pointValue);
+}
+
+Foam::scalar Foam::SmootherOptimiser::objective()
+{
+    const label nCells = _cell.size();
+
+    #pragma omp parallel for schedule(static) num_threads(_nThreads)
+    for (label slotI = 0; slotI < nCells; ++slotI)
+    {
+        _cell[slotI].computeQuality(_bnd);
+        const scalar cQ = _cell[slotI].quality();
+        _cellValue[slotI] = (cQ > VSMALL) ? 1.0/cQ : GREAT;
+    }
+
+    return min(sum(_cellValue), GREAT);
+}
+
+void Foam::SmootherOptimiser::gradient(vectorField& g)
+{
+    const labelListList& pointCells = _bnd.mesh().pointCells();
+    const label nCells = _cell.size();
+
+    // d(1/q) = -dq/q^2 for each cell
+    #pragma omp parallel for schedule(static) num_threads(_nThreads)
+    for (label slotI = 0; slotI < nCells; ++slotI)
+    {
+        const SmootherCell& c = _cell[slotI];
+        const scalar cQ = c.quality();
+        _cellGrad[slotI] = c.qualityGradient(_bnd);
+        forAll(_cellGrad[slotI], pointI)
+        {
+            _cellGrad[slotI][pointI] *= (cQ > VSMALL) ? -1.0/sqr(cQ) : 0.0;
+        }
+    }
+
+    // Gathered per point, the feature points keep the tangent part
+    const label n = _pts.size();
+
+    #pragma omp parallel for schedule(static) num_threads(_nThreads)
+    for (label i = 0; i < n; ++i)
+    {
+        const label ptI = _pts[i];
+        const labelList& pC = pointCells[ptI];
+
+        vector gPt = vector::zero;
+        forAll(pC, cellI)
+        {
+            const label slotI = _cellSlot[pC[cellI]];
+            const SmootherCell& c = _cell[slotI];
+            for (label pointI = 0; pointI < 8; ++pointI)
+            {
+                if (c.pt(pointI) == ptI)
+                {
+                    gPt += _cellGrad[slotI][pointI];
+                }
+            }
+        }
+        g[i] = _bnd.pt(ptI)->tangent(_bnd, gPt);
+    }
+}
+
+void Foam::SmootherOptimiser::place(const scalar alpha)
+{
+    const label n = _pts.size();
+
+    #pragma omp parallel for schedule(static) num_threads(_nThreads)
+    for (label i = 0; i < n; ++i)
+    {
+        SmootherPoint* pt = _bnd.pt(_pts[i]);
+        pt->GETMeReset();
+        pt->addWeight(1.0, _x0[i] + alpha*_p[i]);
+        pt->GETMeSmooth(_bnd);
+        pt->resetPoint(pt->getMovedPoint());
+    }
+}
+
+// * * * * * * * * * * * * * * * * Constructors  * * * * * * * * * * * * * * //
+
+Foam::SmootherOptimiser::SmootherOptimiser
+(
+    const SmootherBoundary& bnd,
+    SmootherPool<SmootherCell>& cell,
+    const labelList& cellSlot,
+    const SmootherControl& ctrl,
+    const label nThreads
+)
+:
+    _bnd(bnd),
+    _cell(cell),
+    _cellSlot(cellSlot),
+    _depth(max(ctrl.lbfgsDepth(), 1)),
+    _nThreads(nThreads),
+    _deterministic(ctrl.deterministic()),
+    _h(0.0),
+    _hasPrev(false),
+    _s(_depth),
+    _y(_depth),
+    _rho(_depth, 0.0),
+    _size(0),
+    _last(0),
+    _cellGrad(cell.size()),
+    _cellValue(cell.size())
+{
+    const polyMesh& mesh = bnd.mesh();
+
+    DynamicList<label> pts(mesh.nPoints());
+    forAll(mesh.points(), ptI)
+    {
+        if (!bnd.pt(ptI)->isFixed())
+        {
+            pts.append(ptI);
+        }
+    }
+    _pts.transfer(pts);
+
+    const label n = _pts.size();
+    _x0.setSize(n);
+    _g.setSize(n);
+    _p.setSize(n);
+    _xPrev.setSize(n);
+    _gPrev.setSize(n);
+    _pointValue.setSize(n);
+    forAll(_s, pairI)
+    {
+        _s[pairI].setSize(n);
+        _y[pairI].setSize(n);
+    }
+
+    const edgeList& edges = mesh.edges();
+    forAll(edges, edgeI)
+    {
+        _h += edges[edgeI].mag(mesh.points());
+    }
+    _h /= max(edges.size(), 1);
+}
+
+// * * * * * * * * * * * * * * * Member Functions  * * * * * * * * * * * * * //
+
+Foam::label Foam::SmootherOptimiser::step(bool& moved)
+{
+    moved = false;
+    const label n = _pts.size();
+    if (n == 0)
+    {
+        return 0;
+    }
+
+    #pragma omp parallel for schedule(static) num_threads(_nThreads)
+    for (label i = 0; i < n; ++i)
+    {
+        _x0[i] = _bnd.pt(_pts[i])->getRelaxedPoint();
+    }
+
+    const scalar F0 = objective();
+    if (F0 >= GREAT)
+    { // Invalid cell, the objective has no gradient
+
+        clear();
+        return 0;
+    }
+    gradient(_g);
+
+    // Pair of the previous step, kept if the curvature is positive
+    if (_hasPrev)
+    {
+        const label next = (_last + 1) % _s.size();
+        vectorField& s = _s[next];
+        vectorField& y = _y[next];
+
+        #pragma omp parallel for schedule(static) num_threads(_nThreads)
+        for (label i = 0; i < n; ++i)
+        {
+            s[i] = _x0[i] - _xPrev[i];
+            y[i] = _g[i] - _gPrev[i];
+        }
+
+        const scalar sy = dot(s, y);
+        if (sy > 1e-10*Foam::sqrt(dot(s, s)*dot(y, y)))
+        {
+            _rho[next] = 1.0/sy;
+            _last = next;
+            _size = min(_size + 1, _s.size());
+        }
+    }
+
+    // Largest gradient, the first step moves the points by a fraction of
+    // the mean edge length
+    scalar gMax = 0.0;
+
+    #pragma omp parallel for schedule(static) num_threads(_nThreads) \
+        reduction(max:gMax)
+    for (label i = 0; i < n; ++i)
+    {
+        gMax = max(gMax, mag(_g[i]));
+    }
+    if (gMax < VSMALL)
+    {
+        return 0;
+    }
+    const scalar gamma0 = 0.05*_h/gMax;
+
+    // Two-loop recursion, p = -H g
+    _p = _g;
+    scalarList alpha(_size);
+    for (label k = _size - 1; k >= 0; --k)
+    {
+        const label e = entry(k);
+        alpha[k] = _rho[e]*dot(_s[e], _p);
+
+        #pragma omp parallel for schedule(static) num_threads(_nThreads)
+        for (label i = 0; i < n; ++i)
+        {
+            _p[i] -= alpha[k]*_y[e][i];
+        }
+    }
+
+    scalar gamma = gamma0;
+    if (_size > 0)
+    {
+        const label e = entry(_size - 1);
+        gamma = 1.0/(_rho[e]*dot(_y[e], _y[e]));
+    }
+    _p *= gamma;
+
+    for (label k = 0; k < _size; ++k)
+    {
+        const label e = entry(k);
+        const scalar beta = _rho[e]*dot(_y[e], _p);
+
+        #pragma omp parallel for schedule(static) num_threads(_nThreads)
+        for (label i = 0; i < n; ++i)
+        {
+            _p[i] += (alpha[k] - beta)*_s[e][i];
+        }
+    }
+
+    #pragma omp parallel for schedule(static) num_threads(_nThreads)
+    for (label i = 0; i < n; ++i)
+    {
+        _p[i] = -_bnd.pt(_pts[i])->tangent(_bnd, _p[i]);
+    }
+
+    scalar gp = dot(_g, _p);
+    if (gp >= 0.0)
+    { // Not a descent direction, back to the gradient
+
+        _size = 0;
+        _p = -gamma0*_g;
+        gp = dot(_g, _p);
+    }
+
+    // Backtracking with the Armijo condition
+    label nTrials = 0;
+    for (scalar a = 1.0; nTrials < 20 && !moved; a *= 0.5)
+    {
+        ++nTrials;
+        place(a);
+        moved = objective() < F0 + 1e-4*a*gp;
+    }
+
+    if (!moved)
+    {
+        #pragma omp parallel for schedule(static) num_threads(_nThreads)
+        for (label i = 0; i < n; ++i)
+        {
+            _bnd.pt(_pts[i])->resetPoint(_x0[i]);
+        }
+        objective();
+        clear();
+
+        return nTrials;
+    }
+
+    _xPrev = _x0;
+    _gPrev = _g;
+    _hasPrev = true;
+
+    return nTrials;
+}
+
+// * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * //
+
+// ************************************************************************* //
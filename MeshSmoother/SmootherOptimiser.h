@@ -0,0 +1,163 @@
+/*---------------------------------------------------------------------------*\
+  extBlockMesh
+  Copyright (C) 2014 Etudes-NG
+  ---------------------------------
+License
+    This file is part of extBlockMesh.
+
+    extBlockMesh is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    extBlockMesh is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+    FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+    for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with extBlockMesh.  If not, see <http://www.gnu.org/licenses/>.
+
+\*---------------------------------------------------------------------------*/
+
+#ifndef SMOOTHEROPTIMISER_H
+#define SMOOTHEROPTIMISER_H
+
+#include "labelList.H"
+#include "scalarField.H"
+#include "pointField.H"
+#include "FixedList.H"
+
+#include "SmootherPool.h"
+
+// * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * //
+
+namespace Foam
+{
+class SmootherBoundary;
+class SmootherCell;
+class SmootherControl;
+
+/*---------------------------------------------------------------------------*\
+                     Class SmootherOptimiser Declaration
+\*---------------------------------------------------------------------------*/
+
+// Global optimisation engine: L-BFGS on the sum of the inverse mean ratio
+// of the cells over the movable points. The gradients of the feature
+// points are projected on the tangent plane or edge of their feature and
+// the moved feature points snapped back like in a GETMe step
+class SmootherOptimiser
+{
+    //- Private data
+
+        // Boundary of the points and table of the cells
+        const SmootherBoundary& _bnd;
+        SmootherPool<SmootherCell>& _cell;
+
+        // Slot of each mesh cell in the cell table
+        const labelList& _cellSlot;
+
+        // Number of point pairs kept by the L-BFGS
+        label _depth;
+
+        // Number of threads of the loops
+        label _nThreads;
+
+        // Are the sums independent of the number of threads
+        bool _deterministic;
+
+        // Movable points, the vertices are fixed
+        labelList _pts;
+
+        // Mean edge length, scale of the first step
+        scalar _h;
+
+        // Points and projected gradient at the start of the step, search
+        // direction
+        pointField _x0;
+        vectorField _g;
+        vectorField _p;
+
+        // Points and gradient of the previous step
+        pointField _xPrev;
+        vectorField _gPrev;
+        bool _hasPrev;
+
+        // Ring of the last depth point and gradient differences
+        List<vectorField> _s;
+        List<vectorField> _y;
+        scalarList _rho;
+        label _size;
+        label _last;
+
+        // Quality gradient of each cell slot
+        List<FixedList<vector, 8> > _cellGrad;
+
+        // Per cell or per point values to sum
+        scalarField _cellValue;
+        scalarField _pointValue;
+
+    //- Private member functions
+
+        // Sum of the values, in fixed blocks if deterministic
+        scalar sum(const scalarField& v) const;
+
+        // Dot product of two point fields
+        scalar dot(const vectorField& a, const vectorField& b);
+
+        // Objective of the relaxed points, GREAT if a cell is invalid, the
+        // cell qualities are updated
+        scalar objective();
+
+        // Projected gradient of the objective at the relaxed points
+        void gradient(vectorField& g);
+
+        // Place the movable points at x0 + alpha p
+        void place(const scalar alpha);
+
+        // Index of the stored pair i, 0 the oldest
+        label entry(const label i) const
+        {
+            return (_last + 1 + i + _s.size() - _size) % _s.size();
+        }
+
+public:
+
+    //- Constructors
+
+        //- Construct from the boundary and the cell table
+        SmootherOptimiser
+        (
+            const SmootherBoundary& bnd,
+            SmootherPool<SmootherCell>& cell,
+            const labelList& cellSlot,
+            const SmootherControl& ctrl,
+            const label nThreads
+        );
+
+    //- Member functions
+
+        // Forget the previous steps, the next one is a gradient step
+        void clear()
+        {
+            _size = 0;
+            _hasPrev = false;
+        }
+
+        // Run one line search, return the number of trial points, the
+        // points are not moved if the objective could not be decreased
+        label step(bool& moved);
+
+        // Number of movable points
+        label size() const {return _pts.size();}
+};
+
+// * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * //
+
+} // End namespace Foam
+
+// * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * //
+
+#endif // SMOOTHEROPTIMISER_H
+
+// ************************************************************************* //
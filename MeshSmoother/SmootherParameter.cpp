@@ -23,7 +23,6 @@ License
 #include "SmootherParameter.h"
 
 #include "polyMesh.H"
-#include "Time.H"
 
 #include "MeshSmoother.h"
 
@@ -40,20 +39,47 @@ Foam::SmootherParameter::SmootherParameter
     _ctrl(control),
     _polyMesh(poly),
     _iterNb(0),
+    _minCycleNb(0),
     _nbMovedPoints(0),
     _nbRelaxations(0),
+    _nbAccepted(0),
+    _nbRejected(0),
+    _nbOptimised(0),
+    _nbGETMeRelax(0),
+    _nbGETMeRelaxCalls(0),
+    _sumStartLevel(0),
+    _maxStartLevel(0),
     _updateTime(0.0),
     _totalTime(0.0),
     _transformTreshold(1.0),
-    _noMinImproveCounter(0)
+    _noMinImproveCounter(0),
+    _log(NULL)
 {
 }
 
+// * * * * * * * * * * * * * * * * Destructor  * * * * * * * * * * * * * * * //
+
+Foam::SmootherParameter::~SmootherParameter()
+{
+    delete _log;
+}
+
+// * * * * * * * * * * * * * * * Private Functions * * * * * * * * * * * * * //
+
+Foam::Ostream& Foam::SmootherParameter::out() const
+{
+    if (_log)
+    {
+        return *_log;
+    }
+    return Info;
+}
+
 // * * * * * * * * * * * * * * * Member Functions  * * * * * * * * * * * * * //
 
 void Foam::SmootherParameter::printHeaders() const
 {
-    Info<< "| Iteration | Mean qual | Min qual  |    Time   |Smooth type|"
+    out()<< "| Iteration | Mean qual | Min qual  |    Time   |Smooth type|"
             "Nb pts move| Nb relax  |Nb unsnaped|" << nl
         << "|-----------|-----------|-----------|-----------|-----------|"
             "-----------|-----------|-----------|"<< nl;
@@ -61,7 +87,7 @@ void Foam::SmootherParameter::printHeaders() const
 
 void Foam::SmootherParameter::printStatus(const label nbUnsnaped)
 {
-    _updateTime = _polyMesh->time().elapsedCpuTime() - _updateTime;
+    _updateTime = _clock.elapsedTime() - _updateTime;
     _totalTime += _updateTime;
 
     const char* cycle =
@@ -74,8 +100,11 @@ void Foam::SmootherParameter::printStatus(const label nbUnsnaped)
                 "snap" :
                 "min ";
 
-    std::printf
+    char line[128];
+    snprintf
     (
+        line,
+        sizeof(line),
         "|    %6i |   %6.4f  |   %6.4f  |  %6.2f   |    %s   |  %8i |    %6i "
         "|    %6i |\n",
         _iterNb,
@@ -87,16 +116,67 @@ void Foam::SmootherParameter::printStatus(const label nbUnsnaped)
         _nbRelaxations,
         nbUnsnaped
     );
+    out()<< line;
 }
 
 void Foam::SmootherParameter::printStats() const
 {
-    Info<< "============================================================="
+    Ostream& os = out();
+    char line[128];
+
+    os  << "============================================================="
            "====================================" << nl;
     const bool isConv = _iterNb < _ctrl->maxIteration() + 1;
     const char* conv = (isConv) ? "Converged in " : "Not converged";
-    std::printf("%s %.3f s\n", conv,_totalTime);
-    Info<< "=====================" << nl;
+    snprintf(line, sizeof(line), "%s %.3f s\n", conv, _totalTime);
+    os  << line;
+    snprintf
+    (
+        line,
+        sizeof(line),
+        "GETMe relaxation rounds: %i, %.2f per relaxation\n",
+        _nbGETMeRelax,
+        scalar(_nbGETMeRelax)/max(_nbGETMeRelaxCalls, 1)
+    );
+    os  << line;
+    if (_ctrl->relaxationMemory())
+    {
+        snprintf
+        (
+            line,
+            sizeof(line),
+            "Highest recalled start level: %.2f per relaxation, %i at most\n",
+            scalar(_sumStartLevel)/max(_nbGETMeRelaxCalls, 1),
+            _maxStartLevel
+        );
+        os  << line;
+    }
+    if (_ctrl->anderson())
+    {
+        os  << "Anderson steps: " << _nbAccepted << " accepted, "
+            << _nbRejected << " rejected" << nl;
+    }
+    if (_ctrl->localOptimisation())
+    {
+        os  << "Locally optimised points: " << _nbOptimised << nl;
+    }
+    os  << "=====================" << nl;
+}
+
+void Foam::SmootherParameter::bufferOutput()
+{
+    delete _log;
+    _log = new OStringStream();
+}
+
+void Foam::SmootherParameter::flushOutput(const word& name)
+{
+    if (_log)
+    {
+        Info<< nl << "Region " << name << nl << _log->str().c_str() << endl;
+        delete _log;
+        _log = NULL;
+    }
 }
 
 bool Foam::SmootherParameter::setSmoothCycle
@@ -153,6 +233,7 @@ bool Foam::SmootherParameter::setSmoothCycle
         }
         _actualCycle = minCycleRunning;
         _noMinImproveCounter = 0;
+        ++_minCycleNb;
 
 //        _transformTreshold = _minQuality + (1.0 - _minQuality)/2.0;
         _transformTreshold = meshSmoother->getTransformationTreshold();
@@ -184,7 +265,7 @@ void Foam::SmootherParameter::setSmoothCycle(const bool asUnSnaped)
 
 void Foam::SmootherParameter::resetUpdateTime()
 {
-    _updateTime = _polyMesh->time().elapsedCpuTime();
+    _updateTime = _clock.elapsedTime();
 }
 
 // * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * //
@@ -24,6 +24,8 @@ License
 #define MESHSMOOTHERPARAMETER_H
 
 #include "scalarList.H"
+#include "clockTime.H"
+#include "OStringStream.H"
 
 #include "SmootherControl.h"
 
@@ -60,8 +62,16 @@ class SmootherParameter
         label _iterNb;
         label _actualCycle;
         label _prevCycle;
+        label _minCycleNb;
         label _nbMovedPoints;
         label _nbRelaxations;
+        label _nbAccepted;
+        label _nbRejected;
+        label _nbOptimised;
+        label _nbGETMeRelax;
+        label _nbGETMeRelaxCalls;
+        label _sumStartLevel;
+        label _maxStartLevel;
         scalar _updateTime;
         scalar _totalTime;
         scalar _transformTreshold;
@@ -69,12 +79,27 @@ class SmootherParameter
         scalar _minQuality;
         scalar _meanQuality;
 
+        // Wall clock of the smoother, the process cpu time adds up the
+        // threads of all the smoothers running concurrently
+        clockTime _clock;
+
+        // Printed status kept until flushOutput, NULL to print directly
+        OStringStream* _log;
+
+    //- Private member functions
+
+        // Stream of the printed status
+        Ostream& out() const;
+
 public:
     //- Constructors
 
         //- Construct from polyMesh and dictionary
         SmootherParameter(SmootherControl *control, polyMesh* poly);
 
+    //- Destructor
+    ~SmootherParameter();
+
     //- Member functions
 
         // Print
@@ -82,6 +107,11 @@ public:
         void printStatus(const label nbUnsnaped);
         void printStats() const;
 
+        // Keep the printed status until flushOutput, for the smoothers
+        // running concurrently
+        void bufferOutput();
+        void flushOutput(const word& name);
+
         // Change smooth cycle
         bool setSmoothCycle
         (
@@ -104,10 +134,45 @@ public:
         const scalar &meanQual() const {return _meanQuality;}
 
         const scalar &transformationTreshold() const{return _transformTreshold;}
+
+        // Is min cycle running
+        bool minCycle() const {return _actualCycle == minCycleRunning;}
+        bool meanCycle() const {return _actualCycle == meanCycleRunning;}
+
+        // Number of min cycles started, changes on each new min cycle
+        const label& minCycleNb() const {return _minCycleNb;}
         inline const scalarList& relaxationTable() const;
 
         void setNbMovedPoints(const scalar& nbMoved) {_nbMovedPoints = nbMoved;}
         void setNbRelaxations(const label nbRelax) {_nbRelaxations = nbRelax;}
+        const label& nbMovedPoints() const {return _nbMovedPoints;}
+        const label& nbRelaxations() const {return _nbRelaxations;}
+
+        // Count the rounds of the GETMe relaxations and the highest level
+        // recalled by their points, the rounds saved at most by the memory
+        void addGETMeRelaxations(const label nbRelax, const label startLevel)
+        {
+            _nbGETMeRelax += nbRelax;
+            ++_nbGETMeRelaxCalls;
+            _sumStartLevel += startLevel;
+            _maxStartLevel = max(_maxStartLevel, startLevel);
+        }
+
+        // Count the points improved by the local optimisation
+        void addOptimisedPoints(const label nb) {_nbOptimised += nb;}
+
+        // Count the accepted and rejected Anderson steps
+        void addAcceleration(const bool accepted)
+        {
+            if (accepted)
+            {
+                ++_nbAccepted;
+            }
+            else
+            {
+                ++_nbRejected;
+            }
+        }
 
         void resetUpdateTime();
 };
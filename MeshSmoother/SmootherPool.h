@@ -0,0 +1,164 @@
+/*---------------------------------------------------------------------------*\
+  extBlockMesh
+  Copyright (C) 2014 Etudes-NG
+  ---------------------------------
+License
+    This file is part of extBlockMesh.
+
+    extBlockMesh is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    extBlockMesh is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+    FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+    for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with extBlockMesh.  If not, see <http://www.gnu.org/licenses/>.
+
+\*---------------------------------------------------------------------------*/
+
+#ifndef SMOOTHERPOOL_H
+#define SMOOTHERPOOL_H
+
+#include "label.H"
+#include "error.H"
+
+#include "SmootherStorage.h"
+
+#include <new>
+
+// * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * //
+
+namespace Foam
+{
+
+/*---------------------------------------------------------------------------*\
+                        Class SmootherPool Declaration
+\*---------------------------------------------------------------------------*/
+
+// Typed arena: objects of one type are placed contiguously in a single
+// allocation and all destroyed and released at once
+template<class Type>
+class SmootherPool
+{
+    //- Private data
+
+        // Raw storage of the objects
+        char* _storage;
+
+        // Number of objects that fit in the storage
+        label _capacity;
+
+        // Number of constructed objects
+        label _size;
+
+        // Backing memory, heap memory if NULL
+        const SmootherStorage* _memory;
+
+    //- Private member functions
+
+        // Disallow copy
+        SmootherPool(const SmootherPool&);
+        void operator=(const SmootherPool&);
+
+public:
+
+    //- Constructors
+
+        //- Construct empty
+        SmootherPool()
+        :
+            _storage(NULL),
+            _capacity(0),
+            _size(0),
+            _memory(NULL)
+        {}
+
+    //- Destructor
+    ~SmootherPool()
+    {
+        clear();
+    }
+
+    //- Member functions
+
+        // Allocate the storage for capacity objects from memory
+        void reserve
+        (
+            const label capacity,
+            const SmootherStorage* memory = NULL
+        )
+        {
+            clear();
+            _memory = memory;
+            if (capacity > 0)
+            {
+                const size_t bytes = capacity*sizeof(Type);
+                _storage = static_cast<char*>
+                (
+                    _memory ? _memory->allocate(bytes) : ::operator new(bytes)
+                );
+            }
+            _capacity = capacity;
+        }
+
+        // Next free slot, the object is built with placement new
+        void* allocate()
+        {
+            if (_size == _capacity)
+            {
+                FatalErrorIn("Foam::SmootherPool::allocate()")
+                    << "Pool of " << _capacity << " objects is full"
+                    << exit(FatalError);
+            }
+            return _storage + sizeof(Type)*(_size++);
+        }
+
+        // Destroy all the objects and release the storage
+        void clear()
+        {
+            for (label i = 0; i < _size; ++i)
+            {
+                reinterpret_cast<Type*>(_storage + sizeof(Type)*i)->~Type();
+            }
+            if (_memory)
+            {
+                _memory->release(_storage, _capacity*sizeof(Type));
+            }
+            else
+            {
+                ::operator delete(_storage);
+            }
+
+            _storage = NULL;
+            _capacity = 0;
+            _size = 0;
+        }
+
+        // Number of constructed objects
+        label size() const {return _size;}
+
+        // Access the constructed objects in allocation order
+        Type& operator[](const label i)
+        {
+            return *reinterpret_cast<Type*>(_storage + sizeof(Type)*i);
+        }
+
+        const Type& operator[](const label i) const
+        {
+            return *reinterpret_cast<const Type*>(_storage + sizeof(Type)*i);
+        }
+};
+
+// * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * //
+
+} // End namespace Foam
+
+// * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * //
+
+#endif // SMOOTHERPOOL_H
+
+// ************************************************************************* //
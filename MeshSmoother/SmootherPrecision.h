@@ -0,0 +1,65 @@
+/*---------------------------------------------------------------------------*\
+  extBlockMesh
+  Copyright (C) 2014 Etudes-NG
+  ---------------------------------
+License
+    This file is part of extBlockMesh.
+
+    extBlockMesh is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    extBlockMesh is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+    FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+    for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with extBlockMesh.  If not, see <http://www.gnu.org/licenses/>.
+
+\*---------------------------------------------------------------------------*/
+
+#ifndef SMOOTHERPRECISION_H
+#define SMOOTHERPRECISION_H
+
+#include "point.H"
+#include "floatVector.H"
+
+// * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * //
+
+namespace Foam
+{
+
+// Storage of the smoother state. With SMOOTHER_MIXED_PRECISION (see
+// Allwmake.sh -mixedPrecision) point positions and qualities are kept in
+// float, determinants and GETMe weighted sums are still computed in double
+#ifdef SMOOTHER_MIXED_PRECISION
+    typedef floatVector storedPoint;
+    typedef float storedScalar;
+#else
+    typedef point storedPoint;
+    typedef scalar storedScalar;
+#endif
+
+// Round a point to the storage precision
+inline storedPoint storePoint(const point& pt)
+{
+    return storedPoint(pt.x(), pt.y(), pt.z());
+}
+
+// Stored point in double precision
+inline point loadPoint(const storedPoint& pt)
+{
+    return point(pt.x(), pt.y(), pt.z());
+}
+
+// * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * //
+
+} // End namespace Foam
+
+// * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * //
+
+#endif // SMOOTHERPRECISION_H
+
+// ************************************************************************* //
@@ -0,0 +1,195 @@
+/*---------------------------------------------------------------------------*\
+  extBlockMesh
+  Copyright (C) 2014 Etudes-NG
+  ---------------------------------
+License
+    This file is part of extBlockMesh.
+
+    extBlockMesh is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    extBlockMesh is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+    FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+    for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with extBlockMesh.  If not, see <http://www.gnu.org/licenses/>.
+
+\*---------------------------------------------------------------------------*/
+
+
+#include "SmootherRenumber.h"
+
+#include "polyMesh.H"
+#include "boundBox.H"
+#include "bandCompression.H"
+#include "ListOps.H"
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include <stdint.h>
+
+// * * * * * * * * * * * * * * * Local Functions * * * * * * * * * * * * * * //
+
+namespace Foam
+{
+    // Spread the 21 low bits of x to every third bit
+    static uint64_t spreadBits(uint64_t x)
+    {
+        x &= 0x1fffffULL;
+        x = (x | x << 32) & 0x1f00000000ffffULL;
+        x = (x | x << 16) & 0x1f0000ff0000ffULL;
+        x = (x | x << 8) & 0x100f00f00f00f00fULL;
+        x = (x | x << 4) & 0x10c30c30c30c30c3ULL;
+        x = (x | x << 2) & 0x1249249249249249ULL;
+        return x;
+    }
+
+    // Cell order along the z-order curve of the cell centres
+    static labelList mortonOrder(const polyMesh& mesh)
+    {
+        const pointField& pts = mesh.points();
+        const labelListList& cellPoints = mesh.cellPoints();
+        const boundBox bb(pts, false);
+        const vector span = cmptMax(bb.span(), vector::one*VSMALL);
+        const scalar nBins = (1 << 21) - 1;
+
+        std::vector<std::pair<uint64_t, label> > key(mesh.nCells());
+        forAll(cellPoints, cellI)
+        {
+            const labelList& cP = cellPoints[cellI];
+            point c = vector::zero;
+            forAll(cP, ptI)
+            {
+                c += pts[cP[ptI]];
+            }
+            c /= cP.size();
+
+            const vector r = cmptDivide(c - bb.min(), span);
+            key[cellI].first =
+                spreadBits(uint64_t(r.x()*nBins))
+              | spreadBits(uint64_t(r.y()*nBins)) << 1
+              | spreadBits(uint64_t(r.z()*nBins)) << 2;
+            key[cellI].second = cellI;
+        }
+        std::sort(key.begin(), key.end());
+
+        labelList order(mesh.nCells());
+        forAll(order, i)
+        {
+            order[i] = key[i].second;
+        }
+        return order;
+    }
+}
+
+// * * * * * * * * * * * * * * * Member Functions  * * * * * * * * * * * * * //
+
+Foam::SmootherRenumber::method Foam::SmootherRenumber::methodFromName
+(
+    const word& name
+)
+{
+    if (name == "none")
+    {
+        return NONE;
+    }
+    else if (name == "morton")
+    {
+        return MORTON;
+    }
+    else if (name == "rcm")
+    {
+        return RCM;
+    }
+
+    FatalErrorIn("Foam::SmootherRenumber::methodFromName(const word&)")
+        << "Unknown renumbering " << name << ", valid methods are "
+        << "none, morton and rcm" << exit(FatalError);
+
+    return NONE;
+}
+
+const char* Foam::SmootherRenumber::methodName(const method m)
+{
+    if (m == MORTON)
+    {
+        return "morton";
+    }
+    else if (m == RCM)
+    {
+        return "rcm";
+    }
+    return "none";
+}
+
+Foam::labelList Foam::SmootherRenumber::cellOrder
+(
+    const polyMesh& mesh,
+    const method m
+)
+{
+    if (m == MORTON)
+    {
+        return mortonOrder(mesh);
+    }
+    else if (m == RCM)
+    {
+        const labelList cmOrder = bandCompression(mesh.cellCells());
+
+        labelList order(cmOrder.size());
+        forAll(cmOrder, i)
+        {
+            order[i] = cmOrder[cmOrder.size() - 1 - i];
+        }
+        return order;
+    }
+
+    return identity(mesh.nCells());
+}
+
+Foam::labelList Foam::SmootherRenumber::pointOrder
+(
+    const polyMesh& mesh,
+    const labelList& cellOrder
+)
+{
+    const labelListList& cellPoints = mesh.cellPoints();
+
+    labelList order(mesh.nPoints());
+    boolList placed(mesh.nPoints(), false);
+    label n = 0;
+
+    forAll(cellOrder, i)
+    {
+        const labelList& cP = cellPoints[cellOrder[i]];
+        forAll(cP, ptI)
+        {
+            if (!placed[cP[ptI]])
+            {
+                placed[cP[ptI]] = true;
+                order[n++] = cP[ptI];
+            }
+        }
+    }
+
+    // Points used by no cell
+    forAll(placed, ptI)
+    {
+        if (!placed[ptI])
+        {
+            order[n++] = ptI;
+        }
+    }
+
+    return order;
+}
+
+// * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * //
+
+// ************************************************************************* //
@@ -0,0 +1,84 @@
+/*---------------------------------------------------------------------------*\
+  extBlockMesh
+  Copyright (C) 2014 Etudes-NG
+  ---------------------------------
+License
+    This file is part of extBlockMesh.
+
+    extBlockMesh is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    extBlockMesh is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+    FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+    for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with extBlockMesh.  If not, see <http://www.gnu.org/licenses/>.
+
+\*---------------------------------------------------------------------------*/
+
+
+#ifndef SMOOTHERRENUMBER_H
+#define SMOOTHERRENUMBER_H
+
+#include "labelList.H"
+#include "word.H"
+
+// * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * //
+
+namespace Foam
+{
+class polyMesh;
+
+/*---------------------------------------------------------------------------*\
+                      Class SmootherRenumber Declaration
+\*---------------------------------------------------------------------------*/
+
+// Placement order of the smoother cells and points, the mesh itself keeps
+// its numbering
+class SmootherRenumber
+{
+public:
+
+    //- Public data
+
+        // Ordering of the cells
+        enum method
+        {
+            NONE,
+            MORTON,
+            RCM
+        };
+
+    //- Static member functions
+
+        // Method from its smootherDict name, none, morton or rcm
+        static method methodFromName(const word& name);
+
+        // Name of the method
+        static const char* methodName(const method m);
+
+        // Cells in placement order, the z-order of the cell centres for
+        // morton, reverse Cuthill-McKee of the cell to cell graph for rcm
+        static labelList cellOrder(const polyMesh& mesh, const method m);
+
+        // Points in order of first use by the cells taken in cellOrder
+        static labelList pointOrder
+        (
+            const polyMesh& mesh,
+            const labelList& cellOrder
+        );
+};
+
+// * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * //
+
+} // End namespace Foam
+
+// * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * //
+
+#endif // SMOOTHERRENUMBER_H
+
+// ************************************************************************* //
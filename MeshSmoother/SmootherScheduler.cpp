@@ -0,0 +1,54 @@
+/*---------------------------------------------------------------------------*\
+  extBlockMesh
+  Copyright (C) 2014 Etudes-NG
+  ---------------------------------
+License
+    This file is part of extBlockMesh.
+
+    extBlockMesh is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    extBlockMesh is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+    FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+    for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with extBlockMesh.  If not, see <http://www.gnu.org/licenses/>.
+
+\*---------------------------------------------------------------------------*/
+
+
+#include "SmootherScheduler.h"
+
+#include "SmootherBoundary.h"
+#include "SmootherPoint.h"
+
+// * * * * * * * * * * * * * * * * Constructors  * * * * * * * * * * * * * * //
+
+Foam::SmootherScheduler::SmootherScheduler
+(
+    const SmootherBoundary& bnd,
+    const labelList& pts,
+    const label nThreads
+)
+:
+    _pts(pts),
+    _offset(pts.size() + 1),
+    _nThreads(nThreads)
+{
+    _offset[0] = 0.0;
+    forAll(_pts, i)
+    {
+        _offset[i + 1] = _offset[i] + bnd.pt(_pts[i])->costHint();
+    }
+
+    // Enough tasks per thread to even out the misestimated costs
+    _grain = max(_offset[_pts.size()]/(16*_nThreads), 256.0);
+}
+
+// * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * //
+
+// ************************************************************************* //
@@ -0,0 +1,159 @@
+/*---------------------------------------------------------------------------*\
+  extBlockMesh
+  Copyright (C) 2014 Etudes-NG
+  ---------------------------------
+License
+    This file is part of extBlockMesh.
+
+    extBlockMesh is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    extBlockMesh is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+    FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+    for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with extBlockMesh.  If not, see <http://www.gnu.org/licenses/>.
+
+\*---------------------------------------------------------------------------*/
+
+
+#ifndef SMOOTHERSCHEDULER_H
+#define SMOOTHERSCHEDULER_H
+
+#include "labelList.H"
+#include "scalarList.H"
+
+#include <algorithm>
+
+// * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * //
+
+namespace Foam
+{
+class SmootherBoundary;
+
+/*---------------------------------------------------------------------------*\
+                     Class SmootherScheduler Declaration
+\*---------------------------------------------------------------------------*/
+
+// Parallel loop over points of uneven update cost: the points are split in
+// halves of equal cost hint down to a grain, each half an OpenMP task so
+// that the idle threads take over the expensive surface projections
+class SmootherScheduler
+{
+    //- Private data
+
+        // Points of the loop
+        labelList _pts;
+
+        // Cost hint of the points before each point, and all of them last
+        scalarList _offset;
+
+        // Cost under which a range is not split
+        scalar _grain;
+
+        // Number of threads of the loop
+        label _nThreads;
+
+    //- Private member functions
+
+        // Run op on the points begin to end, splitting the range
+        template<class Op>
+        void split(const Op* op, const label begin, const label end) const;
+
+public:
+
+    //- Constructors
+
+        //- Construct from the points of the loop and their boundary
+        SmootherScheduler
+        (
+            const SmootherBoundary& bnd,
+            const labelList& pts,
+            const label nThreads
+        );
+
+    //- Member functions
+
+        // Run op(ptI) on all the points
+        template<class Op>
+        void run(const Op& op) const;
+
+        // Same as run from inside an OpenMP parallel region, the tasks
+        // are queued with the ones of the other loops of the region
+        template<class Op>
+        void spawn(const Op& op) const;
+
+        // Number of points of the loop
+        label size() const {return _pts.size();}
+};
+
+template<class Op>
+void SmootherScheduler::split
+(
+    const Op* op,
+    const label begin,
+    const label end
+) const
+{
+    if (end - begin > 1 && _offset[end] - _offset[begin] > _grain)
+    {
+        // Split at half the cost of the range
+        const scalar half = 0.5*(_offset[begin] + _offset[end]);
+        const label mid = min
+        (
+            label
+            (
+                std::upper_bound
+                (
+                    _offset.begin() + begin + 1,
+                    _offset.begin() + end,
+                    half
+                )
+              - _offset.begin()
+            ),
+            end - 1
+        );
+
+        #pragma omp task
+        split(op, begin, mid);
+
+        split(op, mid, end);
+
+        #pragma omp taskwait
+    }
+    else
+    {
+        for (label i = begin; i < end; ++i)
+        {
+            (*op)(_pts[i]);
+        }
+    }
+}
+
+template<class Op>
+void SmootherScheduler::run(const Op& op) const
+{
+    #pragma omp parallel num_threads(_nThreads)
+    #pragma omp single
+    split(&op, 0, _pts.size());
+}
+
+template<class Op>
+void SmootherScheduler::spawn(const Op& op) const
+{
+    split(&op, 0, _pts.size());
+}
+
+// * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * //
+
+} // End namespace Foam
+
+// * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * //
+
+#endif // SMOOTHERSCHEDULER_H
+
+// ************************************************************************* //
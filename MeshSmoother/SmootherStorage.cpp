@@ -0,0 +1,323 @@
+/*---------------------------------------------------------------------------*\
+  extBlockMesh
+  Copyright (C) 2014 Etudes-NG
+  ---------------------------------
+License
+    This file is part of extBlockMesh.
+
+    extBlockMesh is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    extBlockMesh is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+    FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+    for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with extBlockMesh.  If not, see <http://www.gnu.org/licenses/>.
+
+\*---------------------------------------------------------------------------*/
+
+
+#include "SmootherStorage.h"
+
+#include "error.H"
+#include "IOstreams.H"
+#include "labelList.H"
+#include "SmootherControl.h"
+
+#include <new>
+
+#include <sched.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+// * * * * * * * * * * * * * * * Local Functions * * * * * * * * * * * * * * //
+
+namespace Foam
+{
+    // Size of the huge pages of transparent huge pages and hugetlbfs
+    static const size_t hugePageSize = 2*1024*1024;
+
+    // NUMA node of the cpu running the calling thread
+    static label currentNode()
+    {
+        unsigned cpu = 0, node = 0;
+        if (syscall(SYS_getcpu, &cpu, &node, NULL) != 0)
+        {
+            return -1;
+        }
+        return node;
+    }
+}
+
+// * * * * * * * * * * * * * * * Private Functions * * * * * * * * * * * * * //
+
+size_t Foam::SmootherStorage::roundedBytes(const size_t bytes) const
+{
+    if (_hugePages)
+    {
+        return (bytes + hugePageSize - 1)/hugePageSize*hugePageSize;
+    }
+    return bytes;
+}
+
+void Foam::SmootherStorage::touch(void* ptr, const size_t bytes) const
+{
+    const size_t pageSize = sysconf(_SC_PAGESIZE);
+    const label nPages = (bytes + pageSize - 1)/pageSize;
+    char* p = static_cast<char*>(ptr);
+
+    #pragma omp parallel for schedule(static) num_threads(_nThreads)
+    for (label pageI = 0; pageI < nPages; ++pageI)
+    {
+        p[pageI*pageSize] = 0;
+    }
+}
+
+// * * * * * * * * * * * * * * * * Constructors  * * * * * * * * * * * * * * //
+
+Foam::SmootherStorage::SmootherStorage()
+:
+    _outOfCore(false),
+    _firstTouch(false),
+    _hugePages(false),
+    _nThreads(1)
+{}
+
+Foam::SmootherStorage::SmootherStorage
+(
+    const SmootherControl& ctrl,
+    const label nThreads
+)
+:
+    _outOfCore(ctrl.outOfCore()),
+    _scratchDir(ctrl.scratchDir()),
+    _firstTouch(ctrl.firstTouch()),
+    _hugePages(ctrl.hugePages()),
+    _nThreads(nThreads)
+{}
+
+// * * * * * * * * * * * * * * * Member Functions  * * * * * * * * * * * * * //
+
+void* Foam::SmootherStorage::allocate(const size_t bytes) const
+{
+    if (bytes == 0 || (!_outOfCore && !_hugePages))
+    {
+        void* ptr = ::operator new(bytes);
+        if (_firstTouch)
+        {
+            touch(ptr, bytes);
+        }
+        _blocks.push_back(std::make_pair(ptr, bytes));
+        return ptr;
+    }
+
+    const size_t size = roundedBytes(bytes);
+    void* ptr = NULL;
+
+    if (!_outOfCore)
+    {
+        if (posix_memalign(&ptr, hugePageSize, size) != 0)
+        {
+            FatalErrorIn("Foam::SmootherStorage::allocate(const size_t)")
+                << "Cannot allocate " << label(size) << " bytes aligned on "
+                << "huge pages" << exit(FatalError);
+        }
+#ifdef MADV_HUGEPAGE
+        madvise(ptr, size, MADV_HUGEPAGE);
+#endif
+    }
+    else
+    {
+        // A scratchDir on a hugetlbfs mount gives huge pages out of core
+        const fileName name = _scratchDir/"extBlockMeshXXXXXX";
+        std::vector<char> path(name.begin(), name.end());
+        path.push_back('\0');
+
+        const int fd = mkstemp(&path[0]);
+        if (fd < 0)
+        {
+            FatalErrorIn("Foam::SmootherStorage::allocate(const size_t)")
+                << "Cannot create a scratch file in " << _scratchDir
+                << exit(FatalError);
+        }
+
+        // The file is removed once the mapping is released
+        unlink(&path[0]);
+
+        if (ftruncate(fd, size) != 0)
+        {
+            close(fd);
+            FatalErrorIn("Foam::SmootherStorage::allocate(const size_t)")
+                << "Cannot extend a scratch file of " << _scratchDir
+                << " to " << label(size) << " bytes" << exit(FatalError);
+        }
+
+        ptr = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        close(fd);
+
+        if (ptr == MAP_FAILED)
+        {
+            FatalErrorIn("Foam::SmootherStorage::allocate(const size_t)")
+                << "Cannot map " << label(size) << " bytes of "
+                << _scratchDir << exit(FatalError);
+        }
+    }
+
+    if (_firstTouch)
+    {
+        touch(ptr, size);
+    }
+    _blocks.push_back(std::make_pair(ptr, bytes));
+
+    return ptr;
+}
+
+void Foam::SmootherStorage::release(void* ptr, const size_t bytes) const
+{
+    for (size_t i = 0; i < _blocks.size(); ++i)
+    {
+        if (_blocks[i].first == ptr)
+        {
+            _blocks.erase(_blocks.begin() + i);
+            break;
+        }
+    }
+
+    if (bytes == 0 || (!_outOfCore && !_hugePages))
+    {
+        ::operator delete(ptr);
+    }
+    else if (!_outOfCore)
+    {
+        free(ptr);
+    }
+    else if (ptr)
+    {
+        munmap(ptr, roundedBytes(bytes));
+    }
+}
+
+void Foam::SmootherStorage::placementReport() const
+{
+    // Node of each thread, steady only if the threads are pinned
+    labelList threadNode(_nThreads, currentNode());
+#ifdef _OPENMP
+    #pragma omp parallel num_threads(_nThreads)
+    {
+        threadNode[omp_get_thread_num()] = currentNode();
+    }
+#endif
+
+    Info<< "  Memory placement:" << nl
+        << "    - Thread nodes               : " << threadNode << nl;
+
+    const size_t pageSize = sysconf(_SC_PAGESIZE);
+    const label maxSamples = 65536;
+
+    for (size_t blockI = 0; blockI < _blocks.size(); ++blockI)
+    {
+        char* p = static_cast<char*>(_blocks[blockI].first);
+        const label nPages = (_blocks[blockI].second + pageSize - 1)/pageSize;
+        const label nSamples = min(nPages, maxSamples);
+        if (nSamples == 0)
+        {
+            continue;
+        }
+
+        // Sampled pages, the ones never touched have a negative status
+        std::vector<void*> pages(nSamples);
+        std::vector<int> status(nSamples, -1);
+        for (label i = 0; i < nSamples; ++i)
+        {
+            pages[i] = p + (i*nPages/nSamples)*pageSize;
+        }
+        if
+        (
+            syscall
+            (
+                SYS_move_pages, 0, nSamples, &pages[0], NULL, &status[0], 0
+            ) != 0
+        )
+        {
+            Info<< "    - Page nodes not available" << nl;
+            break;
+        }
+
+        label nLocal = 0, nPlaced = 0;
+        for (label i = 0; i < nSamples; ++i)
+        {
+            if (status[i] >= 0)
+            {
+                ++nPlaced;
+                nLocal += (status[i] == threadNode[i*_nThreads/nSamples]);
+            }
+        }
+
+        Info<< "    - Block of " << nPages << " pages         : "
+            << (nPlaced ? 100*nLocal/nPlaced : 0) << "% local, "
+            << (100*nPlaced)/nSamples << "% resident" << nl;
+    }
+    Info<< nl;
+}
+
+void Foam::SmootherStorage::pinThreads
+(
+    const word& policy,
+    const label nThreads
+)
+{
+    if (policy == "none")
+    {
+        return;
+    }
+    else if (policy != "close" && policy != "spread")
+    {
+        FatalErrorIn("Foam::SmootherStorage::pinThreads(const word&, ...)")
+            << "Unknown pinThreads " << policy << ", valid policies are "
+            << "none, close and spread" << exit(FatalError);
+    }
+
+    // Cpus of the process, read before pinning the master thread
+    static std::vector<int> cpus;
+    if (cpus.empty())
+    {
+        cpu_set_t allowed;
+        CPU_ZERO(&allowed);
+        sched_getaffinity(0, sizeof(allowed), &allowed);
+        for (int c = 0; c < CPU_SETSIZE; ++c)
+        {
+            if (CPU_ISSET(c, &allowed))
+            {
+                cpus.push_back(c);
+            }
+        }
+    }
+    const label nCpus = cpus.size();
+
+#ifdef _OPENMP
+    #pragma omp parallel num_threads(nThreads)
+    {
+        const label t = omp_get_thread_num();
+        const label c = policy == "close" ? t : t*nCpus/nThreads;
+
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(cpus[c % nCpus], &set);
+        sched_setaffinity(0, sizeof(set), &set);
+    }
+#endif
+}
+
+// * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * //
+
+// ************************************************************************* //
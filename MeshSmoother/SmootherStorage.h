@@ -0,0 +1,117 @@
+/*---------------------------------------------------------------------------*\
+  extBlockMesh
+  Copyright (C) 2014 Etudes-NG
+  ---------------------------------
+License
+    This file is part of extBlockMesh.
+
+    extBlockMesh is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    extBlockMesh is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+    FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+    for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with extBlockMesh.  If not, see <http://www.gnu.org/licenses/>.
+
+\*---------------------------------------------------------------------------*/
+
+
+#ifndef SMOOTHERSTORAGE_H
+#define SMOOTHERSTORAGE_H
+
+#include "fileName.H"
+#include "label.H"
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+// * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * //
+
+namespace Foam
+{
+class SmootherControl;
+
+/*---------------------------------------------------------------------------*\
+                      Class SmootherStorage Declaration
+\*---------------------------------------------------------------------------*/
+
+// Backing memory of the smoother pools: heap memory in core, or memory
+// mapped files of the scratch directory out of core, then the kernel pages
+// the points and cells in and out and only the working set stays resident.
+// Only the point and cell tables are backed here, the polyMesh and its
+// demand-driven addressing are owned by OpenFOAM and stay in core
+class SmootherStorage
+{
+    //- Private data
+
+        // Are the blocks mapped from scratch files
+        bool _outOfCore;
+
+        // Directory of the scratch files
+        fileName _scratchDir;
+
+        // Are the pages first touched by the threads of the point loops
+        bool _firstTouch;
+
+        // Are the blocks aligned on and advised to use huge pages
+        bool _hugePages;
+
+        // Number of threads of the point loops
+        label _nThreads;
+
+        // Blocks in use, for the placement report
+        mutable std::vector<std::pair<void*, size_t> > _blocks;
+
+    //- Private member functions
+
+        // Size of the mapping or allocation of a block of bytes
+        size_t roundedBytes(const size_t bytes) const;
+
+        // Touch the pages in the static partition of the loops
+        void touch(void* ptr, const size_t bytes) const;
+
+public:
+
+    //- Constructors
+
+        //- Construct in core
+        SmootherStorage();
+
+        //- Construct from smoothControls settings
+        SmootherStorage(const SmootherControl& ctrl, const label nThreads);
+
+    //- Member functions
+
+        // Allocate a block of bytes
+        void* allocate(const size_t bytes) const;
+
+        // Release a block returned by allocate
+        void release(void* ptr, const size_t bytes) const;
+
+        // Are the blocks mapped from scratch files
+        bool outOfCore() const {return _outOfCore;}
+
+        // Print the share of the pages of each block on the NUMA node of
+        // the thread whose static loop partition covers them
+        void placementReport() const;
+
+        // Pin the OpenMP threads to the cpus of the process, close packs
+        // them on consecutive cpus, spread spaces them over all the cpus
+        static void pinThreads(const word& policy, const label nThreads);
+};
+
+// * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * //
+
+} // End namespace Foam
+
+// * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * //
+
+#endif // SMOOTHERSTORAGE_H
+
+// ************************************************************************* //
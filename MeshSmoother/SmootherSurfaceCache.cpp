@@ -0,0 +1,128 @@
+/*---------------------------------------------------------------------------*\
+  extBlockMesh
+  Copyright (C) 2014 Etudes-NG
+  ---------------------------------
+License
+    This file is part of extBlockMesh.
+
+    extBlockMesh is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    extBlockMesh is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+    FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+    for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with extBlockMesh.  If not, see <http://www.gnu.org/licenses/>.
+
+\*---------------------------------------------------------------------------*/
+
+#include "SmootherSurfaceCache.h"
+
+#include "triSurface.H"
+#include "triSurfaceSearch.H"
+#include "surfaceFeatures.H"
+#include "extendedEdgeMesh.H"
+
+// * * * * * * * * * * * * * * * * Constructors  * * * * * * * * * * * * * * //
+
+Foam::SmootherSurfaceCache::SmootherSurfaceCache()
+{
+}
+
+// * * * * * * * * * * * * * * * * Destructor * * * * * * * * * * * * * * * //
+
+Foam::SmootherSurfaceCache::~SmootherSurfaceCache()
+{
+    // Structures referencing a surface are released before it
+    _edgeMeshes.clear();
+    _features.clear();
+    _searches.clear();
+    _surfaces.clear();
+}
+
+// * * * * * * * * * * * * * * * Member Functions  * * * * * * * * * * * * * //
+
+void Foam::SmootherSurfaceCache::insert
+(
+    const fileName& name,
+    triSurface* surf
+)
+{
+    if (found(name))
+    {
+        FatalErrorIn("Foam::SmootherSurfaceCache::insert()")
+            << "Surface " << name << " is already in the cache"
+            << exit(FatalError);
+    }
+    _surfaces.insert(name, surf);
+
+    triSurfaceSearch* search = new triSurfaceSearch(*surf);
+    search->tree();
+    _searches.insert(name, search);
+}
+
+const Foam::triSurfaceSearch* Foam::SmootherSurfaceCache::search
+(
+    const fileName& file
+)
+{
+    if (!found(file))
+    {
+        insert(file, new triSurface(file));
+    }
+
+    return _searches[file];
+}
+
+const Foam::extendedEdgeMesh* Foam::SmootherSurfaceCache::edges
+(
+    const fileName& file,
+    const scalar featureAngle,
+    const scalar minFeatureEdgeLength,
+    const label minEdgeForFeature,
+    const boolList& baffles
+)
+{
+    string key
+    (
+        file + ':' + name(featureAngle) + ':' + name(minFeatureEdgeLength)
+      + ':' + name(minEdgeForFeature) + ':'
+    );
+    forAll(baffles, patchI)
+    {
+        key += baffles[patchI] ? '1' : '0';
+    }
+
+    HashPtrTable<extendedEdgeMesh, string>::iterator iter =
+        _edgeMeshes.find(key);
+    if (iter != _edgeMeshes.end())
+    {
+        return *iter;
+    }
+
+    const triSurface& surf = search(file)->surface();
+
+    surfaceFeatures* sF = new surfaceFeatures
+    (
+        surf,
+        featureAngle,
+        minFeatureEdgeLength,
+        minEdgeForFeature,
+        false
+    );
+    _features.insert(key, sF);
+
+    extendedEdgeMesh* eM = new extendedEdgeMesh(*sF, baffles);
+    eM->edgeTree();
+    _edgeMeshes.insert(key, eM);
+
+    return eM;
+}
+
+// * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * //
+
+// ************************************************************************* //
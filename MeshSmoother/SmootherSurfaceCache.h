@@ -0,0 +1,108 @@
+/*---------------------------------------------------------------------------*\
+  extBlockMesh
+  Copyright (C) 2014 Etudes-NG
+  ---------------------------------
+License
+    This file is part of extBlockMesh.
+
+    extBlockMesh is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    extBlockMesh is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+    FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+    for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with extBlockMesh.  If not, see <http://www.gnu.org/licenses/>.
+
+\*---------------------------------------------------------------------------*/
+
+#ifndef SMOOTHERSURFACECACHE_H
+#define SMOOTHERSURFACECACHE_H
+
+#include "HashPtrTable.H"
+#include "boolList.H"
+#include "fileName.H"
+
+// * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * //
+
+namespace Foam
+{
+class triSurface;
+class triSurfaceSearch;
+class surfaceFeatures;
+class extendedEdgeMesh;
+
+/*---------------------------------------------------------------------------*\
+                   Class SmootherSurfaceCache Declaration
+\*---------------------------------------------------------------------------*/
+
+// Snapping surfaces read from files, shared by the smoothers of the regions
+// referencing the same triSurface. The search trees are built on creation,
+// the structures are then only read and can be used from several threads.
+class SmootherSurfaceCache
+{
+    //- Private data
+
+        // Surfaces and their search by file path
+        HashPtrTable<triSurface, fileName> _surfaces;
+        HashPtrTable<triSurfaceSearch, fileName> _searches;
+
+        // Feature edges by file path and feature settings
+        HashPtrTable<surfaceFeatures, string> _features;
+        HashPtrTable<extendedEdgeMesh, string> _edgeMeshes;
+
+    //- Private member functions
+
+        // Disallow copy
+        SmootherSurfaceCache(const SmootherSurfaceCache&);
+        void operator=(const SmootherSurfaceCache&);
+
+public:
+
+    //- Constructors
+
+        //- Construct empty
+        SmootherSurfaceCache();
+
+    //- Destructor
+    ~SmootherSurfaceCache();
+
+    //- Member functions
+
+        // Add a surface built in memory, the cache takes its ownership
+        // and the snapControls can reference it by name
+        void insert(const fileName& name, triSurface* surf);
+
+        // Is the surface in the cache
+        bool found(const fileName& file) const {return _surfaces.found(file);}
+
+        // Search of the surface file, read on first use
+        const triSurfaceSearch* search(const fileName& file);
+
+        // Feature edges of the surface file for the snapControls settings
+        const extendedEdgeMesh* edges
+        (
+            const fileName& file,
+            const scalar featureAngle,
+            const scalar minFeatureEdgeLength,
+            const label minEdgeForFeature,
+            const boolList& baffles
+        );
+
+        // Number of surfaces read
+        label size() const {return _surfaces.size();}
+};
+
+// * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * //
+
+} // End namespace Foam
+
+// * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * //
+
+#endif // SMOOTHERSURFACECACHE_H
+
+// ************************************************************************* //
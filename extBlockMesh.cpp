@@ -44,6 +44,14 @@ Usage
     \param -dict \<filename\> \n
     Specify alternative dictionary for the block mesh description.
 
+    \param -allRegions \n
+    Mesh every region with a blockMeshDict and smooth them concurrently,
+    the smootherDict of a region is read from \a system/\<region\> if
+    present.
+
+    \param -nThreads \<N\> \n
+    Thread budget shared by the regions, split evenly between them.
+
 \*---------------------------------------------------------------------------*/
 /*---------------------------------------------------------------------------*\
   extBlockMesh
@@ -81,6 +89,7 @@ License
 #include "Pair.H"
 #include "slidingInterface.H"
 #include "blockMesh.H"
+#include "fvMesh.H"
 
 // -- Added from OpenFOAM
 #include "lineEdge.H"
@@ -89,6 +98,7 @@ License
 
 // -- Created class
 #include "MeshSmoother.h"
+#include "SmootherSurfaceCache.h"
 //-----------------------------------------
 
 using namespace Foam;
@@ -114,6 +124,17 @@ int main(int argc, char *argv[])
         "file",
         "specify alternative dictionary for the blockMesh description"
     );
+    argList::addBoolOption
+    (
+        "allRegions",
+        "mesh and smooth concurrently all the regions with a blockMeshDict"
+    );
+    argList::addOption
+    (
+        "nThreads",
+        "N",
+        "threads shared by the regions (default all)"
+    );
 
 #   include "addRegionOption.H"
 #   include "setRootCase.H"
@@ -121,166 +142,294 @@ int main(int argc, char *argv[])
 
     const word dictName("blockMeshDict");
 
-    word regionName;
-    fileName polyMeshDir;
+    wordList regionNames;
 
-    if (args.optionReadIfPresent("region", regionName, polyMesh::defaultRegion))
+    if (args.optionFound("allRegions"))
     {
+        if
+        (
+            args.optionFound("dict")
+         || args.optionFound("blockTopology")
+         || args.optionFound("writeStep")
+        )
+        {
+            FatalErrorIn(args.executable())
+                << "-allRegions cannot be used with -dict, -blockTopology "
+                << "or -writeStep" << exit(FatalError);
+        }
+
         // constant/<region>/polyMesh/blockMeshDict
-        polyMeshDir = regionName/polyMesh::meshSubDir;
+        regionNames = MeshSmoother::findRegions(runTime, dictName);
+
+        if (regionNames.empty())
+        {
+            FatalErrorIn(args.executable())
+                << "No region with a " << dictName << " in "
+                << runTime.constant() << exit(FatalError);
+        }
 
-        Info<< nl << "Generating mesh for region " << regionName << endl;
+        Info<< nl << "Generating mesh for regions " << regionNames << endl;
     }
     else
     {
-        // constant/polyMesh/blockMeshDict
-        polyMeshDir = polyMesh::meshSubDir;
+        regionNames.setSize(1);
+
+        if
+        (
+            args.optionReadIfPresent
+            (
+                "region",
+                regionNames[0],
+                polyMesh::defaultRegion
+            )
+        )
+        {
+            Info<< nl << "Generating mesh for region " << regionNames[0]
+                << endl;
+        }
     }
 
-    IOobject meshDictIO
-    (
-        dictName,
-        runTime.constant(),
-        polyMeshDir,
-        runTime,
-        IOobject::MUST_READ,
-        IOobject::NO_WRITE,
-        false
-    );
+    const label nRegions = regionNames.size();
+
+    // Snapping surfaces read once for all the regions
+    SmootherSurfaceCache surfCache;
+
+    // Thread budget shared by the regions
+    const label nThreads = args.optionLookupOrDefault<label>("nThreads", 0);
+    const label regionThreads =
+        MeshSmoother::regionThreads(nThreads, nRegions);
+
+    PtrList<IOdictionary> meshDicts(nRegions);
+    PtrList<blockMesh> blockMeshes(nRegions);
+    PtrList<polyMesh> meshes(nRegions);
+    PtrList<IOdictionary> smootherDicts(nRegions);
+    PtrList<MeshSmoother> smoothers(nRegions);
+
+    word defaultFacesName = "defaultFaces";
+    word defaultFacesType = emptyPolyPatch::typeName;
 
-    if (args.optionFound("dict"))
+    blockMesh::verbose(false);
+
+    forAll(regionNames, regionI)
     {
-        const fileName dictPath = args["dict"];
+        word& regionName = regionNames[regionI];
+
+        fileName polyMeshDir;
+        fileName systemDir;
 
-        meshDictIO = IOobject
+        if (regionName != polyMesh::defaultRegion)
+        {
+            // constant/<region>/polyMesh/blockMeshDict
+            polyMeshDir = regionName/polyMesh::meshSubDir;
+            systemDir = regionName;
+        }
+        else
+        {
+            // constant/polyMesh/blockMeshDict
+            polyMeshDir = polyMesh::meshSubDir;
+        }
+
+        IOobject meshDictIO
         (
-            (
-                isDir(dictPath)
-              ? dictPath/dictName
-              : dictPath
-            ),
+            dictName,
+            runTime.constant(),
+            polyMeshDir,
             runTime,
             IOobject::MUST_READ,
             IOobject::NO_WRITE,
             false
         );
-    }
 
-    if (!meshDictIO.headerOk())
-    {
-        FatalErrorIn(args.executable())
-            << "Cannot open mesh description file\n    "
-            << meshDictIO.objectPath()
-            << nl
-            << exit(FatalError);
-    }
+        if (args.optionFound("dict"))
+        {
+            const fileName dictPath = args["dict"];
 
-    Info<< "Creating block mesh from\n    "
-        << meshDictIO.objectPath() << endl;
+            meshDictIO = IOobject
+            (
+                (
+                    isDir(dictPath)
+                  ? dictPath/dictName
+                  : dictPath
+                ),
+                runTime,
+                IOobject::MUST_READ,
+                IOobject::NO_WRITE,
+                false
+            );
+        }
 
-    blockMesh::verbose(false);
+        if (!meshDictIO.headerOk())
+        {
+            FatalErrorIn(args.executable())
+                << "Cannot open mesh description file\n    "
+                << meshDictIO.objectPath()
+                << nl
+                << exit(FatalError);
+        }
 
-    IOdictionary meshDict(meshDictIO);
-    blockMesh blocks(meshDict, regionName);
+        Info<< "Creating block mesh from\n    "
+            << meshDictIO.objectPath() << endl;
 
-    if (args.optionFound("blockTopology"))
-    {
-        // Write mesh as edges.
+        meshDicts.set(regionI, new IOdictionary(meshDictIO));
+        blockMeshes.set(regionI, new blockMesh(meshDicts[regionI], regionName));
+        blockMesh& blocks = blockMeshes[regionI];
+
+        if (args.optionFound("blockTopology"))
         {
-            fileName objMeshFile("blockTopology.obj");
+            // Write mesh as edges.
+            {
+                fileName objMeshFile("blockTopology.obj");
 
-            OFstream str(runTime.path()/objMeshFile);
+                OFstream str(runTime.path()/objMeshFile);
 
-            Info<< nl << "Dumping block structure as Lightwave obj format"
-                << " to " << objMeshFile << endl;
+                Info<< nl << "Dumping block structure as Lightwave obj format"
+                    << " to " << objMeshFile << endl;
 
-            blocks.writeTopology(str);
-        }
+                blocks.writeTopology(str);
+            }
 
-        // Write centres of blocks
-        {
-            fileName objCcFile("blockCentres.obj");
+            // Write centres of blocks
+            {
+                fileName objCcFile("blockCentres.obj");
 
-            OFstream str(runTime.path()/objCcFile);
+                OFstream str(runTime.path()/objCcFile);
 
-            Info<< nl << "Dumping block centres as Lightwave obj format"
-                << " to " << objCcFile << endl;
+                Info<< nl << "Dumping block centres as Lightwave obj format"
+                    << " to " << objCcFile << endl;
 
-            const polyMesh& topo = blocks.topology();
+                const polyMesh& topo = blocks.topology();
 
-            const pointField& cellCentres = topo.cellCentres();
+                const pointField& cellCentres = topo.cellCentres();
 
-            forAll(cellCentres, cellI)
-            {
-                //point cc = b.blockShape().centre(b.points());
-                const point& cc = cellCentres[cellI];
+                forAll(cellCentres, cellI)
+                {
+                    //point cc = b.blockShape().centre(b.points());
+                    const point& cc = cellCentres[cellI];
 
-                str << "v " << cc.x() << ' ' << cc.y() << ' ' << cc.z() << nl;
+                    str << "v " << cc.x() << ' ' << cc.y() << ' ' << cc.z()
+                        << nl;
+                }
             }
-        }
-
-        Info<< nl << "end" << endl;
-
-        return 0;
-    }
 
+            Info<< nl << "end" << endl;
 
-    Info<< nl << "Creating polyMesh from blockMesh" << endl;
+            return 0;
+        }
 
-    word defaultFacesName = "defaultFaces";
-    word defaultFacesType = emptyPolyPatch::typeName;
+        Info<< nl << "Creating polyMesh from blockMesh" << endl;
 
-    polyMesh mesh
-    (
-        IOobject
+        // With -writeStep the mesh is directly an fvMesh to write the
+        // quality field along
+        IOobject meshIO
         (
             regionName,
             runTime.constant(),
             runTime
-        ),
-        xferCopy(blocks.points()),           // could we re-use space?
-        blocks.cells(),
-        blocks.patches(),
-        blocks.patchNames(),
-        blocks.patchDicts(),
-        defaultFacesName,
-        defaultFacesType
-    );
+        );
+
+        if (args.optionFound("writeStep"))
+        {
+            meshes.set
+            (
+                regionI,
+                new fvMesh
+                (
+                    meshIO,
+                    xferCopy(blocks.points()),
+                    blocks.cells(),
+                    blocks.patches(),
+                    blocks.patchNames(),
+                    blocks.patchDicts(),
+                    defaultFacesName,
+                    defaultFacesType
+                )
+            );
+        }
+        else
+        {
+            meshes.set
+            (
+                regionI,
+                new polyMesh
+                (
+                    meshIO,
+                    xferCopy(blocks.points()),
+                    blocks.cells(),
+                    blocks.patches(),
+                    blocks.patchNames(),
+                    blocks.patchDicts(),
+                    defaultFacesName,
+                    defaultFacesType
+                )
+            );
+        }
 
-    // ########################################################################
-    // Smoothing
+        // The mesh holds a copy of the merged blockMesh points. Release the
+        // points and cells of each block, they are rebuilt on demand for the
+        // cell zones
+        blocks.clearGeom();
 
-    Info<< nl << "Initialize smoother algorithm" << nl;
+        // ####################################################################
+        // Smoothing
 
-    const word smootherDictName("smootherDict");
-    IOobject smootherDictIO
-    (
-        smootherDictName,
-        runTime.system(),
-        "",
-        runTime,
-        IOobject::MUST_READ,
-        IOobject::NO_WRITE,
-        false
-    );
+        Info<< nl << "Initialize smoother algorithm" << nl;
 
-    if (!smootherDictIO.headerOk())
-    {
-        FatalErrorIn(args.executable())
-            << "Cannot open mesh smoothing file\n    "
-            << smootherDictIO.objectPath()
-            << nl
-            << exit(FatalError);
-    }
+        // system/<region>/smootherDict, system/smootherDict by default
+        const word smootherDictName("smootherDict");
+        IOobject smootherDictIO
+        (
+            smootherDictName,
+            runTime.system(),
+            systemDir,
+            runTime,
+            IOobject::MUST_READ,
+            IOobject::NO_WRITE,
+            false
+        );
 
-    IOdictionary smootherDict(smootherDictIO);
-    MeshSmoother meshSmoother(&mesh, &smootherDict, &blocks);
+        if (!smootherDictIO.headerOk())
+        {
+            smootherDictIO = IOobject
+            (
+                smootherDictName,
+                runTime.system(),
+                "",
+                runTime,
+                IOobject::MUST_READ,
+                IOobject::NO_WRITE,
+                false
+            );
+        }
+
+        if (!smootherDictIO.headerOk())
+        {
+            FatalErrorIn(args.executable())
+                << "Cannot open mesh smoothing file\n    "
+                << smootherDictIO.objectPath()
+                << nl
+                << exit(FatalError);
+        }
+
+        smootherDicts.set(regionI, new IOdictionary(smootherDictIO));
+        smoothers.set
+        (
+            regionI,
+            new MeshSmoother
+            (
+                &meshes[regionI],
+                &smootherDicts[regionI],
+                &blocks,
+                &surfCache,
+                regionThreads
+            )
+        );
+    }
 
     if (args.optionFound("writeStep"))
     {
-        meshSmoother.updateAndWrite
+        smoothers[0].updateAndWrite
         (
-            regionName,
+            regionNames[0],
             defaultFacesName,
             defaultFacesType,
             runTime
@@ -288,164 +437,176 @@ int main(int argc, char *argv[])
     }
     else
     {
-        meshSmoother.update();
+        MeshSmoother::updateAll(smoothers, nThreads);
 
-        // Reset mesh directory to constant/polyMesh !!! Hard to find :P
-        mesh.setInstance(runTime.constant());
+        forAll(meshes, regionI)
+        {
+            // Reset mesh directory to constant/polyMesh !!! Hard to find :P
+            meshes[regionI].setInstance(runTime.constant());
+        }
     }
+    smoothers.clear();
 
     // End of smoothing
     //##########################################################################
 
-    // Read in a list of dictionaries for the merge patch pairs
-    if (meshDict.found("mergePatchPairs"))
-    {
-        List<Pair<word> > mergePatchPairs
-        (
-            meshDict.lookup("mergePatchPairs")
-        );
+    // Set the precision of the points data to 10
+    IOstream::defaultPrecision(max(10u, IOstream::defaultPrecision()));
 
-#       include "mergePatchPairs.H"
-    }
-    else
+    forAll(meshes, regionI)
     {
-        Info<< nl << "There are no merge patch pairs edges" << endl;
-    }
+        polyMesh& mesh = meshes[regionI];
+        const blockMesh& blocks = blockMeshes[regionI];
+        const IOdictionary& meshDict = meshDicts[regionI];
+
+        // Read in a list of dictionaries for the merge patch pairs
+        if (meshDict.found("mergePatchPairs"))
+        {
+            List<Pair<word> > mergePatchPairs
+            (
+                meshDict.lookup("mergePatchPairs")
+            );
 
+#           include "mergePatchPairs.H"
+        }
+        else
+        {
+            Info<< nl << "There are no merge patch pairs edges" << endl;
+        }
 
-    // Set any cellZones (note: cell labelling unaffected by above
-    // mergePatchPairs)
 
-    label nZones = blocks.numZonedBlocks();
+        // Set any cellZones (note: cell labelling unaffected by above
+        // mergePatchPairs)
 
-    if (nZones > 0)
-    {
-        Info<< nl << "Adding cell zones" << endl;
+        label nZones = blocks.numZonedBlocks();
 
-        // Map from zoneName to cellZone index
-        HashTable<label> zoneMap(nZones);
+        if (nZones > 0)
+        {
+            Info<< nl << "Adding cell zones" << endl;
 
-        // Cells per zone.
-        List<DynamicList<label> > zoneCells(nZones);
+            // Map from zoneName to cellZone index
+            HashTable<label> zoneMap(nZones);
 
-        // Running cell counter
-        label cellI = 0;
+            // Cells per zone.
+            List<DynamicList<label> > zoneCells(nZones);
 
-        // Largest zone so far
-        label freeZoneI = 0;
+            // Running cell counter
+            label cellI = 0;
 
-        forAll(blocks, blockI)
-        {
-            const block& b = blocks[blockI];
-            const labelListList& blockCells = b.cells();
-            const word& zoneName = b.blockDef().zoneName();
+            // Largest zone so far
+            label freeZoneI = 0;
 
-            if (zoneName.size())
+            forAll(blocks, blockI)
             {
-                HashTable<label>::const_iterator iter = zoneMap.find(zoneName);
-
-                label zoneI;
+                const block& b = blocks[blockI];
+                const labelListList& blockCells = b.cells();
+                const word& zoneName = b.blockDef().zoneName();
 
-                if (iter == zoneMap.end())
+                if (zoneName.size())
                 {
-                    zoneI = freeZoneI++;
+                    HashTable<label>::const_iterator iter =
+                        zoneMap.find(zoneName);
 
-                    Info<< "    " << zoneI << '\t' << zoneName << endl;
+                    label zoneI;
 
-                    zoneMap.insert(zoneName, zoneI);
+                    if (iter == zoneMap.end())
+                    {
+                        zoneI = freeZoneI++;
+
+                        Info<< "    " << zoneI << '\t' << zoneName << endl;
+
+                        zoneMap.insert(zoneName, zoneI);
+                    }
+                    else
+                    {
+                        zoneI = iter();
+                    }
+
+                    forAll(blockCells, i)
+                    {
+                        zoneCells[zoneI].append(cellI++);
+                    }
                 }
                 else
                 {
-                    zoneI = iter();
-                }
-
-                forAll(blockCells, i)
-                {
-                    zoneCells[zoneI].append(cellI++);
+                    cellI += b.cells().size();
                 }
             }
-            else
-            {
-                cellI += b.cells().size();
-            }
-        }
 
 
-        List<cellZone*> cz(zoneMap.size());
+            List<cellZone*> cz(zoneMap.size());
 
-        Info<< nl << "Writing cell zones as cellSets" << endl;
+            Info<< nl << "Writing cell zones as cellSets" << endl;
 
-        forAllConstIter(HashTable<label>, zoneMap, iter)
-        {
-            label zoneI = iter();
-
-            cz[zoneI] = new cellZone
-            (
-                iter.key(),
-                zoneCells[zoneI].shrink(),
-                zoneI,
-                mesh.cellZones()
-            );
+            forAllConstIter(HashTable<label>, zoneMap, iter)
+            {
+                label zoneI = iter();
+
+                cz[zoneI] = new cellZone
+                (
+                    iter.key(),
+                    zoneCells[zoneI].shrink(),
+                    zoneI,
+                    mesh.cellZones()
+                );
+
+                // Write as cellSet for ease of processing
+                cellSet cset(mesh, iter.key(), zoneCells[zoneI].shrink());
+                cset.write();
+            }
 
-            // Write as cellSet for ease of processing
-            cellSet cset(mesh, iter.key(), zoneCells[zoneI].shrink());
-            cset.write();
+            mesh.pointZones().setSize(0);
+            mesh.faceZones().setSize(0);
+            mesh.cellZones().setSize(0);
+            mesh.addZones(List<pointZone*>(0), List<faceZone*>(0), cz);
         }
 
-        mesh.pointZones().setSize(0);
-        mesh.faceZones().setSize(0);
-        mesh.cellZones().setSize(0);
-        mesh.addZones(List<pointZone*>(0), List<faceZone*>(0), cz);
-    }
-
-    // Set the precision of the points data to 10
-    IOstream::defaultPrecision(max(10u, IOstream::defaultPrecision()));
-
-    Info<< nl << "Writing polyMesh" << endl;
+        Info<< nl << "Writing polyMesh" << endl;
 
-    // #########################################################################
+        // #####################################################################
 
-    if (!args.optionFound("writeStep"))
-    {
-        mesh.removeFiles();
-        if (!mesh.write())
+        if (!args.optionFound("writeStep"))
         {
-            FatalErrorIn(args.executable())
-                << "Failed writing polyMesh."
-                << exit(FatalError);
+            mesh.removeFiles();
+            if (!mesh.write())
+            {
+                FatalErrorIn(args.executable())
+                    << "Failed writing polyMesh."
+                    << exit(FatalError);
+            }
         }
-    }
 
-    // #########################################################################
+        // #####################################################################
 
-    //
-    // write some information
-    //
-    {
-        const polyPatchList& patches = mesh.boundaryMesh();
-
-        Info<< "----------------" << nl
-            << "Mesh Information" << nl
-            << "----------------" << nl
-            << "  " << "boundingBox: " << boundBox(mesh.points()) << nl
-            << "  " << "nPoints: " << mesh.nPoints() << nl
-            << "  " << "nCells: " << mesh.nCells() << nl
-            << "  " << "nFaces: " << mesh.nFaces() << nl
-            << "  " << "nInternalFaces: " << mesh.nInternalFaces() << nl;
-
-        Info<< "----------------" << nl
-            << "Patches" << nl
-            << "----------------" << nl;
-
-        forAll(patches, patchI)
+        //
+        // write some information
+        //
         {
-            const polyPatch& p = patches[patchI];
+            const polyPatchList& patches = mesh.boundaryMesh();
+
+            Info<< "----------------" << nl
+                << "Mesh Information" << nl
+                << "----------------" << nl
+                << "  " << "boundingBox: " << boundBox(mesh.points()) << nl
+                << "  " << "nPoints: " << mesh.nPoints() << nl
+                << "  " << "nCells: " << mesh.nCells() << nl
+                << "  " << "nFaces: " << mesh.nFaces() << nl
+                << "  " << "nInternalFaces: " << mesh.nInternalFaces() << nl;
+
+            Info<< "----------------" << nl
+                << "Patches" << nl
+                << "----------------" << nl;
+
+            forAll(patches, patchI)
+            {
+                const polyPatch& p = patches[patchI];
 
-            Info<< "  " << "patch " << patchI
-                << " (start: " << p.start()
-                << " size: " << p.size()
-                << ") name: " << p.name()
-                << nl;
+                Info<< "  " << "patch " << patchI
+                    << " (start: " << p.start()
+                    << " size: " << p.size()
+                    << ") name: " << p.name()
+                    << nl;
+            }
         }
     }
 
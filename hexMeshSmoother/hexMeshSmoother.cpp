@@ -43,6 +43,7 @@ License
 
 // -- Created class
 #include "MeshSmoother.h"
+#include "SmootherSurfaceCache.h"
 //-----------------------------------------
 
 using namespace Foam;
@@ -52,37 +53,137 @@ using namespace Foam;
 int main(int argc, char *argv[])
 {
     argList::noParallel();
+    argList::addBoolOption
+    (
+        "allRegions",
+        "smooth concurrently all the regions of the case"
+    );
+    argList::addOption
+    (
+        "nThreads",
+        "N",
+        "threads shared by the regions (default all)"
+    );
 
 #   include "addRegionOption.H"
 #   include "setRootCase.H"
 #   include "createTime.H"
-#   include "createMesh.H"
 
-    Info<< nl << "Initialize smoother algorithm" << nl;
+    wordList regionNames;
 
-    const word smootherDictName("smootherDict");
-    IOobject smootherDictIO
-    (
-        smootherDictName,
-        runTime.system(),
-        "",
-        runTime,
-        IOobject::MUST_READ,
-        IOobject::NO_WRITE,
-        false
-    );
+    if (args.optionFound("allRegions"))
+    {
+        // constant/<region>/polyMesh/faces
+        regionNames = MeshSmoother::findRegions(runTime, "faces");
 
-    if (!smootherDictIO.headerOk())
+        if (regionNames.empty())
+        {
+            FatalErrorIn(args.executable())
+                << "No mesh region in " << runTime.constant()
+                << exit(FatalError);
+        }
+
+        Info<< nl << "Smoothing regions " << regionNames << endl;
+    }
+    else
     {
-        FatalErrorIn(args.executable())
-            << "Cannot open mesh smoothing file\n    "
-            << smootherDictIO.objectPath()
-            << nl
-            << exit(FatalError);
+        regionNames.setSize(1);
+        args.optionReadIfPresent
+        (
+            "region",
+            regionNames[0],
+            polyMesh::defaultRegion
+        );
     }
 
-    IOdictionary smootherDict(smootherDictIO);
-    MeshSmoother meshSmoother(&mesh, &smootherDict);
+    const label nRegions = regionNames.size();
+
+    // Snapping surfaces read once for all the regions
+    SmootherSurfaceCache surfCache;
+
+    // Thread budget shared by the regions
+    const label nThreads = args.optionLookupOrDefault<label>("nThreads", 0);
+    const label regionThreads =
+        MeshSmoother::regionThreads(nThreads, nRegions);
+
+    PtrList<fvMesh> meshes(nRegions);
+    PtrList<IOdictionary> smootherDicts(nRegions);
+    PtrList<MeshSmoother> smoothers(nRegions);
+
+    forAll(regionNames, regionI)
+    {
+        const word& regionName = regionNames[regionI];
+
+        Info<< "Create mesh for region " << regionName << " for time = "
+            << runTime.timeName() << nl << endl;
+
+        meshes.set
+        (
+            regionI,
+            new fvMesh
+            (
+                IOobject
+                (
+                    regionName,
+                    runTime.timeName(),
+                    runTime,
+                    IOobject::MUST_READ
+                )
+            )
+        );
+
+        Info<< nl << "Initialize smoother algorithm" << nl;
+
+        // system/<region>/smootherDict, system/smootherDict by default
+        const word smootherDictName("smootherDict");
+        IOobject smootherDictIO
+        (
+            smootherDictName,
+            runTime.system(),
+            regionName != polyMesh::defaultRegion ? regionName : word::null,
+            runTime,
+            IOobject::MUST_READ,
+            IOobject::NO_WRITE,
+            false
+        );
+
+        if (!smootherDictIO.headerOk())
+        {
+            smootherDictIO = IOobject
+            (
+                smootherDictName,
+                runTime.system(),
+                "",
+                runTime,
+                IOobject::MUST_READ,
+                IOobject::NO_WRITE,
+                false
+            );
+        }
+
+        if (!smootherDictIO.headerOk())
+        {
+            FatalErrorIn(args.executable())
+                << "Cannot open mesh smoothing file\n    "
+                << smootherDictIO.objectPath()
+                << nl
+                << exit(FatalError);
+        }
+
+        smootherDicts.set(regionI, new IOdictionary(smootherDictIO));
+        smoothers.set
+        (
+            regionI,
+            new MeshSmoother
+            (
+                &meshes[regionI],
+                &smootherDicts[regionI],
+                0,
+                &surfCache,
+                regionThreads
+            )
+        );
+    }
 
     // TODO add writeStep option for hexMeshSmoother
 //    if (args.optionFound("writeStep"))
@@ -97,56 +198,65 @@ int main(int argc, char *argv[])
 //    }
 //    else
     {
-        meshSmoother.update();
+        MeshSmoother::updateAll(smoothers, nThreads);
 
-        // Reset mesh directory to constant/polyMesh !!! Hard to find :P
-        mesh.setInstance(runTime.constant());
+        forAll(meshes, regionI)
+        {
+            // Reset mesh directory to constant/polyMesh !!! Hard to find :P
+            meshes[regionI].setInstance(runTime.constant());
+        }
     }
+    smoothers.clear();
 
     // Set the precision of the points data to 10
     IOstream::defaultPrecision(max(10u, IOstream::defaultPrecision()));
 
-    Info<< nl << "Writing polyMesh" << endl;
-
-    if (!args.optionFound("writeStep"))
+    forAll(meshes, regionI)
     {
-        mesh.removeFiles();
-        if (!mesh.write())
+        fvMesh& mesh = meshes[regionI];
+
+        Info<< nl << "Writing polyMesh" << endl;
+
+        if (!args.optionFound("writeStep"))
         {
-            FatalErrorIn(args.executable())
-                << "Failed writing polyMesh."
-                << exit(FatalError);
+            mesh.removeFiles();
+            if (!mesh.write())
+            {
+                FatalErrorIn(args.executable())
+                    << "Failed writing polyMesh."
+                    << exit(FatalError);
+            }
         }
-    }
 
-    //
-    // write some information
-    //
-    {
-        const polyPatchList& patches = mesh.boundaryMesh();
-
-        Info<< "----------------" << nl
-            << "Mesh Information" << nl
-            << "----------------" << nl
-            << "  " << "boundingBox: " << boundBox(mesh.points()) << nl
-            << "  " << "nPoints: " << mesh.nPoints() << nl
-            << "  " << "nCells: " << mesh.nCells() << nl
-            << "  " << "nFaces: " << mesh.nFaces() << nl
-            << "  " << "nInternalFaces: " << mesh.nInternalFaces() << nl;
-
-        Info<< "----------------" << nl
-            << "Patches" << nl
-            << "----------------" << nl;
-
-        forAll(patches, patchI)
+        //
+        // write some information
+        //
         {
-            const polyPatch& p = patches[patchI];
-
-            Info<< "  " << "patch " << patchI
-                << " (start: " << p.start()
-                << " size: " << p.size()
-                << ") name: " << p.name()
-                << nl;
+            const polyPatchList& patches = mesh.boundaryMesh();
+
+            Info<< "----------------" << nl
+                << "Mesh Information" << nl
+                << "----------------" << nl
+                << "  " << "boundingBox: " << boundBox(mesh.points()) << nl
+                << "  " << "nPoints: " << mesh.nPoints() << nl
+                << "  " << "nCells: " << mesh.nCells() << nl
+                << "  " << "nFaces: " << mesh.nFaces() << nl
+                << "  " << "nInternalFaces: " << mesh.nInternalFaces() << nl;
+
+            Info<< "----------------" << nl
+                << "Patches" << nl
+                << "----------------" << nl;
+
+            forAll(patches, patchI)
+            {
+                const polyPatch& p = patches[patchI];
+
+                Info<< "  " << "patch " << patchI
+                    << " (start: " << p.start()
+                    << " size: " << p.size()
+                    << ") name: " << p.name()
+                    << nl;
+            }
         }
     }
 
@@ -157,4 +267,3 @@ int main(int argc, char *argv[])
 
 
 // ************************************************************************* //
-
@@ -0,0 +1,744 @@
+/*---------------------------------------------------------------------------*\
+  extBlockMesh
+  Copyright (C) 2014 Etudes-NG
+  ---------------------------------
+License
+    This file is part of extBlockMesh.
+
+    extBlockMesh is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    extBlockMesh is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+    FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+    for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with extBlockMesh.  If not, see <http://www.gnu.org/licenses/>.
+
+Description
+    Time the cell quality and GETMe transformation kernels on the hexahedra
+    of the case mesh and report their error against the std::pow reference.
+
+    The error of storing the points and qualities in float is reported too.
+    The gather rows time the quality computed from a shared point table with
+    the cells and points placed in mesh order, z-order and reverse
+    Cuthill-McKee order, the cache misses of the gathers making the gap.
+    The reduction rows compare the mean quality summed by an OpenMP reduction
+    with the deterministic block and tree sum, the error being the relative
+    difference with the serial sum.
+    With -schedules, the hexahedral case mesh and a randomly perturbed
+    lattice of the unit cube (-latticeSize cells per direction) are smoothed
+    with the jacobi and multicolour GETMe schedules of system/smootherDict,
+    the boundaries being kept as they are, and their iterations, time and
+    quality are compared.
+    With -referenceTime, the quality of the case mesh is compared with the
+    points of a time directory, e.g. the same case smoothed by a build with
+    another point storage precision.
+
+\*---------------------------------------------------------------------------*/
+
+#include "argList.H"
+#include "Time.H"
+#include "polyMesh.H"
+#include "pointIOField.H"
+#include "cellModeller.H"
+#include "clockTime.H"
+#include "IOdictionary.H"
+#include "Random.H"
+
+// -- Created class
+#include "SmootherInMemory.h"
+#include "SmootherKernel.h"
+#include "SmootherRenumber.h"
+//-----------------------------------------
+
+#include <cstdio>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+using namespace Foam;
+
+// * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * //
+
+// Error of a kernel against the reference
+struct kernelError
+{
+    scalar max;
+    scalar mean;
+    scalar maxRegular;
+};
+
+kernelError qualityError(const scalarField& q, const scalarField& ref)
+{
+    kernelError err = {0.0, 0.0, 0.0};
+    label nValid = 0;
+
+    forAll(ref, cellI)
+    {
+        if (ref[cellI] > VSMALL)
+        {
+            const scalar e = mag(q[cellI] - ref[cellI])/ref[cellI];
+
+            err.max = max(err.max, e);
+            err.mean += e;
+            ++nValid;
+
+            // Cells close to orthonormal where fastPow is known to drift
+            if (ref[cellI] > 0.95)
+            {
+                err.maxRegular = max(err.maxRegular, e);
+            }
+        }
+    }
+    err.mean /= max(nValid, 1);
+
+    return err;
+}
+
+void printHeaders()
+{
+    Info<< "| Kernel                  |  ns/cell  | Max error | Mean error|"
+           "Max err>.95|" << nl
+        << "|-------------------------|-----------|-----------|-----------|"
+           "-----------|" << nl;
+}
+
+void printRow(const char* name, const scalar ns, const kernelError& err)
+{
+    std::printf
+    (
+        "| %-23s | %9.2f | %9.3e | %9.3e | %9.3e |\n",
+        name,
+        ns,
+        err.max,
+        err.mean,
+        err.maxRegular
+    );
+}
+
+// Point rounded to single precision
+point roundToFloat(const point& pt)
+{
+    return point(float(pt.x()), float(pt.y()), float(pt.z()));
+}
+
+// Copy the hexahedra in point-major structure of arrays
+void toSoA
+(
+    const List<FixedList<point, 8> >& hexes,
+    scalarField& x,
+    scalarField& y,
+    scalarField& z
+)
+{
+    const label n = hexes.size();
+    x.setSize(8*n);
+    y.setSize(8*n);
+    z.setSize(8*n);
+
+    forAll(hexes, cellI)
+    {
+        for (label p = 0; p < 8; ++p)
+        {
+            x[p*n + cellI] = hexes[cellI][p].x();
+            y[p*n + cellI] = hexes[cellI][p].y();
+            z[p*n + cellI] = hexes[cellI][p].z();
+        }
+    }
+}
+
+// Hexahedral lattice of n^3 cells of the unit cube, the interior points
+// randomly moved by up to perturbation times the cell size in each direction
+void perturbedLattice
+(
+    const label n,
+    const scalar perturbation,
+    pointField& points,
+    labelList& hexes
+)
+{
+    const label np = n + 1;
+    const scalar h = 1.0/n;
+    Random rndGen(1234);
+
+    points.setSize(np*np*np);
+    for (label k = 0; k < np; ++k)
+    {
+        for (label j = 0; j < np; ++j)
+        {
+            for (label i = 0; i < np; ++i)
+            {
+                point pt(i*h, j*h, k*h);
+                if
+                (
+                    i > 0 && i < n
+                 && j > 0 && j < n
+                 && k > 0 && k < n
+                )
+                {
+                    for (direction d = 0; d < 3; ++d)
+                    {
+                        pt[d] += (2.0*rndGen.scalar01() - 1.0)*perturbation*h;
+                    }
+                }
+                points[i + np*(j + np*k)] = pt;
+            }
+        }
+    }
+
+    // Corners in the cellShape order of the hex model
+    static const label di[8] = {0, 1, 1, 0, 0, 1, 1, 0};
+    static const label dj[8] = {0, 0, 1, 1, 0, 0, 1, 1};
+    static const label dk[8] = {0, 0, 0, 0, 1, 1, 1, 1};
+
+    hexes.setSize(8*n*n*n);
+    label cellI = 0;
+    for (label k = 0; k < n; ++k)
+    {
+        for (label j = 0; j < n; ++j)
+        {
+            for (label i = 0; i < n; ++i)
+            {
+                for (label p = 0; p < 8; ++p)
+                {
+                    hexes[8*cellI + p] =
+                        (i + di[p]) + np*((j + dj[p]) + np*(k + dk[p]));
+                }
+                ++cellI;
+            }
+        }
+    }
+}
+
+// Smooth the hexahedra with each GETMe schedule and print their rows
+void compareSchedules
+(
+    const char* caseName,
+    dictionary& smootherDict,
+    const pointField& points,
+    const labelList& hexes,
+    const wordList& patchNames,
+    const List<faceList>& patchFaces
+)
+{
+    const word schedules[] = {"jacobi", "multicolour"};
+
+    for (label sI = 0; sI < 2; ++sI)
+    {
+        smootherDict.subDict("smoothControls").set("schedule", schedules[sI]);
+
+        SmootherInMemory smoother(smootherDict);
+        pointField pts(points);
+
+        clockTime timer;
+        const scalarField cQ = smoother.smooth
+        (
+            pts,
+            hexes,
+            patchNames,
+            patchFaces
+        );
+        const scalar time = timer.timeIncrement();
+
+        std::printf
+        (
+            "| %-9s | %-11s | %10d | %9.2f | %11.4f | %11.4f |\n",
+            caseName,
+            schedules[sI].c_str(),
+            int(smoother.nbIterations()),
+            time,
+            min(cQ),
+            average(cQ)
+        );
+    }
+}
+
+// * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * //
+
+int main(int argc, char *argv[])
+{
+    argList::noParallel();
+    argList::addOption
+    (
+        "nRepeat",
+        "N",
+        "number of timed passes over the cells (default 10)"
+    );
+    argList::addOption
+    (
+        "referenceTime",
+        "time",
+        "compare the mesh quality with the points of this time"
+    );
+    argList::addBoolOption
+    (
+        "schedules",
+        "compare the jacobi and multicolour GETMe schedules"
+    );
+    argList::addOption
+    (
+        "latticeSize",
+        "N",
+        "cells per direction of the -schedules perturbed lattice (default 20)"
+    );
+
+#   include "addRegionOption.H"
+#   include "setRootCase.H"
+#   include "createTime.H"
+#   include "createNamedPolyMesh.H"
+
+    const label nRepeat = args.optionLookupOrDefault<label>("nRepeat", 10);
+
+    // Collect the hexahedra of the mesh
+    const cellModel& hex = *(cellModeller::lookup("hex"));
+    const cellShapeList& shapes = mesh.cellShapes();
+    const pointField& meshPts = mesh.points();
+
+    DynamicList<FixedList<point, 8> > hexList(shapes.size());
+    DynamicList<label> hexCells(shapes.size());
+    forAll(shapes, cellI)
+    {
+        if (shapes[cellI].model() == hex)
+        {
+            FixedList<point, 8> pts;
+            forAll(pts, ptI)
+            {
+                pts[ptI] = meshPts[shapes[cellI][ptI]];
+            }
+            hexList.append(pts);
+            hexCells.append(cellI);
+        }
+    }
+    const List<FixedList<point, 8> > hexes(hexList.xfer());
+    const label n = hexes.size();
+
+    if (n == 0)
+    {
+        FatalErrorIn(args.executable())
+            << "No hexahedral cell in mesh " << mesh.name()
+            << exit(FatalError);
+    }
+
+    // Reference quality and its distribution in the mesh
+    scalarField ref(n);
+    forAll(hexes, cellI)
+    {
+        ref[cellI] = SmootherKernel::hexQuality(hexes[cellI]);
+    }
+
+    Info<< nl << "Benchmark of " << n << " hexahedra over " << nRepeat
+        << " passes" << nl
+        << "  - Min quality  : " << min(ref) << nl
+        << "  - Mean quality : " << average(ref) << nl << nl;
+
+    scalarField x, y, z;
+    toSoA(hexes, x, y, z);
+
+    // ------------------------------------------------------------------------
+    // Quality kernels
+
+    printHeaders();
+
+    const SmootherKernel::powMethod methods[] =
+    {
+        SmootherKernel::STDPOW,
+        SmootherKernel::CBRT,
+        SmootherKernel::FASTPOW
+    };
+
+    scalarField q(n);
+    for (label mI = 0; mI < 3; ++mI)
+    {
+        const SmootherKernel::powMethod m = methods[mI];
+
+        clockTime timer;
+        for (label r = 0; r < nRepeat; ++r)
+        {
+            forAll(hexes, cellI)
+            {
+                q[cellI] = SmootherKernel::hexQuality(hexes[cellI], m);
+            }
+        }
+        const scalar ns = timer.elapsedTime()*1e9/(nRepeat*n);
+
+        const std::string name = SmootherKernel::powMethodName(m);
+        printRow(name.c_str(), ns, qualityError(q, ref));
+
+        timer.timeIncrement();
+        for (label r = 0; r < nRepeat; ++r)
+        {
+            SmootherKernel::hexQualityBatch(n, x.cdata(), y.cdata(), z.cdata(),
+                q.data(), m);
+        }
+        const scalar nsBatch = timer.timeIncrement()*1e9/(nRepeat*n);
+
+        const std::string batchName = name + " batch";
+        printRow(batchName.c_str(), nsBatch, qualityError(q, ref));
+    }
+
+    // ------------------------------------------------------------------------
+    // Transformation kernels, error relative to the mean edge length
+
+    Info<< nl;
+    printHeaders();
+
+    const scalar t = 0.666;
+    List<FixedList<point, 8> > H(n);
+    {
+        clockTime timer;
+        for (label r = 0; r < nRepeat; ++r)
+        {
+            forAll(hexes, cellI)
+            {
+                SmootherKernel::transform(hexes[cellI], t, H[cellI]);
+            }
+        }
+        const kernelError noErr = {0.0, 0.0, 0.0};
+        printRow("transform", timer.elapsedTime()*1e9/(nRepeat*n), noErr);
+    }
+    {
+        scalarField hx(8*n), hy(8*n), hz(8*n);
+
+        clockTime timer;
+        for (label r = 0; r < nRepeat; ++r)
+        {
+            SmootherKernel::transformBatch(n, x.cdata(), y.cdata(), z.cdata(),
+                t, hx.data(), hy.data(), hz.data());
+        }
+        const scalar ns = timer.elapsedTime()*1e9/(nRepeat*n);
+
+        kernelError err = {0.0, 0.0, 0.0};
+        forAll(hexes, cellI)
+        {
+            scalar length = 0.0;
+            for (label p = 0; p < 4; ++p)
+            {
+                length += mag(hexes[cellI][p] - hexes[cellI][(p + 1) % 4]);
+            }
+            length /= 4.0;
+
+            scalar e = 0.0;
+            for (label p = 0; p < 8; ++p)
+            {
+                const point hB(hx[p*n + cellI], hy[p*n + cellI], hz[p*n+cellI]);
+                e = max(e, mag(hB - H[cellI][p])/length);
+            }
+
+            err.max = max(err.max, e);
+            err.mean += e;
+            if (ref[cellI] > 0.95)
+            {
+                err.maxRegular = max(err.maxRegular, e);
+            }
+        }
+        err.mean /= n;
+
+        printRow("transform batch", ns, err);
+    }
+
+    // ------------------------------------------------------------------------
+    // Points and quality stored in float, quality computed in double
+
+    Info<< nl;
+    printHeaders();
+    {
+        clockTime timer;
+        for (label r = 0; r < nRepeat; ++r)
+        {
+            forAll(hexes, cellI)
+            {
+                FixedList<point, 8> pts;
+                forAll(pts, ptI)
+                {
+                    pts[ptI] = roundToFloat(hexes[cellI][ptI]);
+                }
+                q[cellI] = float(SmootherKernel::hexQuality(pts));
+            }
+        }
+        const scalar ns = timer.elapsedTime()*1e9/(nRepeat*n);
+
+        printRow("float storage", ns, qualityError(q, ref));
+    }
+
+    // ------------------------------------------------------------------------
+    // Gather of the cell points from a shared point table in placement order
+
+    Info<< nl;
+    printHeaders();
+    {
+        labelList hexIndex(shapes.size(), -1);
+        forAll(hexCells, cellI)
+        {
+            hexIndex[hexCells[cellI]] = cellI;
+        }
+
+        const SmootherRenumber::method renumbering[] =
+        {
+            SmootherRenumber::NONE,
+            SmootherRenumber::MORTON,
+            SmootherRenumber::RCM
+        };
+
+        for (label mI = 0; mI < 3; ++mI)
+        {
+            const SmootherRenumber::method m = renumbering[mI];
+            const labelList cellOrder = SmootherRenumber::cellOrder(mesh, m);
+            const labelList pointSlot = invert
+            (
+                mesh.nPoints(),
+                SmootherRenumber::pointOrder(mesh, cellOrder)
+            );
+
+            // Placed points and point slots of the placed hexahedra
+            pointField pts(meshPts.size());
+            forAll(pointSlot, ptI)
+            {
+                pts[pointSlot[ptI]] = meshPts[ptI];
+            }
+
+            labelList hexOrder(n);
+            List<FixedList<label, 8> > slots(n);
+            label k = 0;
+            forAll(cellOrder, i)
+            {
+                const label hexI = hexIndex[cellOrder[i]];
+                if (hexI >= 0)
+                {
+                    const cellShape& shape = shapes[cellOrder[i]];
+                    forAll(slots[k], ptI)
+                    {
+                        slots[k][ptI] = pointSlot[shape[ptI]];
+                    }
+                    hexOrder[k++] = hexI;
+                }
+            }
+
+            scalarField qPlaced(n);
+            clockTime timer;
+            for (label r = 0; r < nRepeat; ++r)
+            {
+                forAll(slots, hexI)
+                {
+                    FixedList<point, 8> h;
+                    forAll(h, ptI)
+                    {
+                        h[ptI] = pts[slots[hexI][ptI]];
+                    }
+                    qPlaced[hexI] = SmootherKernel::hexQuality(h);
+                }
+            }
+            const scalar ns = timer.elapsedTime()*1e9/(nRepeat*n);
+
+            forAll(hexOrder, hexI)
+            {
+                q[hexOrder[hexI]] = qPlaced[hexI];
+            }
+
+            const std::string name =
+                std::string("gather ") + SmootherRenumber::methodName(m);
+            printRow(name.c_str(), ns, qualityError(q, ref));
+        }
+    }
+
+    // ------------------------------------------------------------------------
+    // Sum of the cell qualities, fast and deterministic reductions
+
+    Info<< nl;
+    printHeaders();
+    {
+#ifdef _OPENMP
+        const label nThreads = omp_get_max_threads();
+#else
+        const label nThreads = 1;
+#endif
+        const scalar* v = ref.cdata();
+
+        scalar serialSum = 0.0;
+        clockTime timer;
+        for (label r = 0; r < nRepeat; ++r)
+        {
+            serialSum = 0.0;
+            for (label i = 0; i < n; ++i)
+            {
+                serialSum += v[i];
+            }
+        }
+        const kernelError noErr = {0.0, 0.0, 0.0};
+        printRow("serial sum", timer.timeIncrement()*1e9/(nRepeat*n), noErr);
+
+        scalar fastSum = 0.0;
+        for (label r = 0; r < nRepeat; ++r)
+        {
+            fastSum = 0.0;
+            #pragma omp parallel for schedule(static) num_threads(nThreads) \
+                reduction(+:fastSum)
+            for (label i = 0; i < n; ++i)
+            {
+                fastSum += v[i];
+            }
+        }
+        const scalar nsFast = timer.timeIncrement()*1e9/(nRepeat*n);
+        const scalar eFast = mag(fastSum - serialSum)/serialSum;
+        const kernelError fastErr = {eFast, eFast, 0.0};
+        printRow("OpenMP reduction", nsFast, fastErr);
+
+        scalar detSum = 0.0;
+        for (label r = 0; r < nRepeat; ++r)
+        {
+            detSum = SmootherKernel::deterministicSum(v, n, nThreads);
+        }
+        const scalar nsDet = timer.timeIncrement()*1e9/(nRepeat*n);
+        const scalar eDet = mag(detSum - serialSum)/serialSum;
+        const kernelError detErr = {eDet, eDet, 0.0};
+        printRow("deterministic sum", nsDet, detErr);
+
+        Info<< "  - Threads : " << nThreads << nl;
+    }
+
+    // ------------------------------------------------------------------------
+    // Jacobi and multicolour GETMe schedules on the case mesh and on a
+    // perturbed lattice
+
+    if (args.optionFound("schedules"))
+    {
+        if (n != mesh.nCells())
+        {
+            FatalErrorIn(args.executable())
+                << "Schedules are compared on hexahedral meshes only, mesh "
+                << mesh.name() << " has " << mesh.nCells() - n
+                << " other cells" << exit(FatalError);
+        }
+
+        IOdictionary smootherDict
+        (
+            IOobject
+            (
+                "smootherDict",
+                runTime.system(),
+                runTime,
+                IOobject::MUST_READ,
+                IOobject::NO_WRITE,
+                false
+            )
+        );
+
+        // Boundaries are not snapped, only the interior is smoothed
+        smootherDict.subDict("snapControls").remove("boundaries");
+
+        labelList hexLabels(8*n);
+        forAll(shapes, cellI)
+        {
+            for (label ptI = 0; ptI < 8; ++ptI)
+            {
+                hexLabels[8*cellI + ptI] = shapes[cellI][ptI];
+            }
+        }
+
+        const polyBoundaryMesh& bM = mesh.boundaryMesh();
+        List<faceList> patchFaces(bM.size());
+        forAll(bM, patchI)
+        {
+            patchFaces[patchI] = faceList(bM[patchI]);
+        }
+
+        Info<< nl
+            << "| Case      | Schedule    | Iterations |  Time (s) |"
+               " Min quality | Mean quality|" << nl
+            << "|-----------|-------------|------------|-----------|"
+               "-------------|-------------|" << nl;
+
+        compareSchedules
+        (
+            "case",
+            smootherDict,
+            meshPts,
+            hexLabels,
+            bM.names(),
+            patchFaces
+        );
+
+        // Lattice with all its boundary faces in the default patch
+        const label nLattice =
+            args.optionLookupOrDefault<label>("latticeSize", 20);
+        pointField latticePts;
+        labelList latticeHexes;
+        perturbedLattice(nLattice, 0.3, latticePts, latticeHexes);
+
+        compareSchedules
+        (
+            "lattice",
+            smootherDict,
+            latticePts,
+            latticeHexes,
+            wordList(),
+            List<faceList>()
+        );
+    }
+
+    // ------------------------------------------------------------------------
+    // Final quality against the reference points
+
+    if (args.optionFound("referenceTime"))
+    {
+        const word refTime = args.optionRead<word>("referenceTime");
+
+        pointIOField refPts
+        (
+            IOobject
+            (
+                "points",
+                refTime,
+                mesh.meshDir(),
+                runTime,
+                IOobject::MUST_READ,
+                IOobject::NO_WRITE,
+                false
+            )
+        );
+
+        if (refPts.size() != meshPts.size())
+        {
+            FatalErrorIn(args.executable())
+                << "Reference time " << refTime << " has " << refPts.size()
+                << " points, mesh " << mesh.name() << " has "
+                << meshPts.size() << exit(FatalError);
+        }
+
+        scalarField qRef(n);
+        forAll(hexCells, cellI)
+        {
+            const cellShape& shape = shapes[hexCells[cellI]];
+
+            FixedList<point, 8> pts;
+            forAll(pts, ptI)
+            {
+                pts[ptI] = refPts[shape[ptI]];
+            }
+            qRef[cellI] = SmootherKernel::hexQuality(pts);
+        }
+
+        const kernelError err = qualityError(ref, qRef);
+
+        Info<< nl << "Final quality against time " << refTime << nl
+            << "  - Min quality  : " << min(ref) << " (reference "
+            << min(qRef) << ")" << nl
+            << "  - Mean quality : " << average(ref) << " (reference "
+            << average(qRef) << ")" << nl
+            << "  - Max cell quality difference  : " << err.max << nl
+            << "  - Mean cell quality difference : " << err.mean << nl
+            << "  - Max point distance : " << max(mag(meshPts - refPts))
+            << nl;
+    }
+
+    Info<< "\nEnd\n" << endl;
+
+    return 0;
+}
+
+
+// ************************************************************************* //